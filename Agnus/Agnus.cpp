@@ -448,6 +448,28 @@ Agnus::updateSpriteDMA()
     }
 }
 
+Agnus::LineHooks
+Agnus::lineHooks()
+{
+    return LineHooks(dmaDebugger,
+                     paula,
+                     paula.channel0,
+                     paula.channel1,
+                     paula.channel2,
+                     paula.channel3);
+}
+
+Agnus::FrameHooks
+Agnus::frameHooks()
+{
+    return FrameHooks(sequencer,
+                      copper,
+                      denise,
+                      controlPort1.joystick,
+                      controlPort2.joystick,
+                      retroShell);
+}
+
 void
 Agnus::hsyncHandler()
 {
@@ -456,17 +478,8 @@ Agnus::hsyncHandler()
     // Let Denise finish up the current line
     denise.endOfLine(pos.v);
 
-    // Update pot counters
-    if (paula.chargeX0 < 1.0) paula.potCntX0++;
-    if (paula.chargeY0 < 1.0) paula.potCntY0++;
-    if (paula.chargeX1 < 1.0) paula.potCntX1++;
-    if (paula.chargeY1 < 1.0) paula.potCntY1++;
-
-    // Transfer DMA requests from Paula to Agnus
-    paula.channel0.requestDMA();
-    paula.channel1.requestDMA();
-    paula.channel2.requestDMA();
-    paula.channel3.requestDMA();
+    // Let all subscribed components finish up the current line
+    lineHooks().hsync();
 
     // Advance the vertical counter
     if (++pos.v >= frame.numLines()) vsyncHandler();
@@ -477,7 +490,8 @@ Agnus::hsyncHandler()
     bplcon1Initial = bplcon1;
     
     // Clear the bus usage table
-    for (isize i = 0; i < HPOS_CNT; i++) busOwner[i] = BUS_NONE;
+    static_assert(sizeof(BusOwner) == 1 && BUS_NONE == 0);
+    std::memset(busOwner, BUS_NONE, sizeof(busOwner));
 
     // Pass control to the sequencer
     sequencer.hsyncHandler();
@@ -506,12 +520,7 @@ Agnus::vsyncHandler()
     pos.v = 0;
             
     // Let other components do their own VSYNC stuff
-    sequencer.vsyncHandler();
-    copper.vsyncHandler();
-    denise.vsyncHandler();
-    controlPort1.joystick.vsyncHandler();
-    controlPort2.joystick.vsyncHandler();
-    retroShell.vsyncHandler();
+    frameHooks().vsync();
 
     // Update statistics
     updateStats();
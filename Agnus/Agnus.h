@@ -22,9 +22,12 @@
 #include "DmaDebugger.h"
 #include "Scheduler.h"
 #include "Sequencer.h"
+#include "SyncHooks.h"
 #include "Frame.h"
 #include "Memory.h"
 
+template <isize nr> class StateMachine;
+
 /* Bitplane event modifiers
  *
  *                DRAW_ODD : Starts the shift registers of the odd bitplanes
@@ -60,6 +63,16 @@ public:
     Blitter blitter = Blitter(amiga);
     DmaDebugger dmaDebugger = DmaDebugger(amiga);
 
+    // Components that are notified at the end of each rasterline
+    using LineHooks = SyncHooks <DmaDebugger, Paula,
+    StateMachine<0>, StateMachine<1>, StateMachine<2>, StateMachine<3>>;
+    LineHooks lineHooks();
+
+    // Components that are notified at the end of each frame
+    using FrameHooks = SyncHooks <Sequencer, Copper, Denise,
+    Joystick, Joystick, RetroShell>;
+    FrameHooks frameHooks();
+
 
     //
     // Execution control
@@ -473,6 +486,13 @@ public:
     // Attempts to allocate the bus for the specified resource
     template <BusOwner owner> bool allocateBus();
 
+    /* Returns the first cycle in which a blocked resource should try again
+     * to acquire the bus. If the bus is occupied, all upcoming cycles with
+     * bitplane DMA are skipped. The search stops at the next recorded
+     * register change, because it might modify the DMA tables.
+     */
+    Cycle nextBusCycle();
+
     // Performs a DMA read
     u16 doDiskDmaRead();
     template <int channel> u16 doAudioDmaRead();
@@ -10,6 +10,7 @@
 #include "config.h"
 #include "Agnus.h"
 #include "Denise.h"
+#include <algorithm>
 
 template <> bool Agnus::auddma<0>(u16 v) { return (v & DMAEN) && (v & AUD0EN); }
 template <> bool Agnus::auddma<1>(u16 v) { return (v & DMAEN) && (v & AUD1EN); }
@@ -79,6 +80,24 @@ Agnus::allocateBus()
     }
 }
 
+Cycle
+Agnus::nextBusCycle()
+{
+    Cycle next = clock + DMA_CYCLES(1);
+
+    if constexpr (NO_BUS_SKIP) return next;
+
+    // Check if the bus is occupied
+    if (busOwner[pos.h] == BUS_NONE) return next;
+
+    /* No other component can change the DMA tables while the bus is occupied.
+     * The CPU is blocked and the Copper and the Blitter are unable to acquire
+     * the bus. Only a recorded register change can interfere.
+     */
+    Cycle gap = clock + DMA_CYCLES(sequencer.nextBplGap[pos.h] - pos.h);
+    return std::max(next, std::min(gap, changeRecorder.trigger()));
+}
+
 u16
 Agnus::doDiskDmaRead()
 {
@@ -404,6 +404,11 @@ public:
     void serviceEvent();
     void serviceEvent(EventID id);
 
+private:
+
+    // Postpones the current event to the next usable bus cycle
+    void waitForBus();
+
 
     //
     // Running the sub-units
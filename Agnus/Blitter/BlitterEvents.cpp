@@ -17,6 +17,12 @@ Blitter::serviceEvent()
     serviceEvent(scheduler.id[SLOT_BLT]);
 }
 
+void
+Blitter::waitForBus()
+{
+    scheduler.rescheduleAbs<SLOT_BLT>(agnus.nextBusCycle());
+}
+
 void
 Blitter::serviceEvent(EventID id)
 {
@@ -36,6 +42,7 @@ Blitter::serviceEvent(EventID id)
             // Only proceed if the bus is free
             if (!agnus.busIsFree<BUS_BLITTER>()) {
                 trace(BLTTIM_DEBUG, "BLT_STRT1: Blocked by %d\n", agnus.busOwner[agnus.pos.h]);
+                waitForBus();
                 break;
             }
 
@@ -48,6 +55,7 @@ Blitter::serviceEvent(EventID id)
             // Only proceed if the bus is a free
             if (!agnus.busIsFree<BUS_BLITTER>()) {
                 trace(BLTTIM_DEBUG, "BLT_STRT2: Blocked by %d\n", agnus.busOwner[agnus.pos.h]);
+                waitForBus();
                 break;
             }
 
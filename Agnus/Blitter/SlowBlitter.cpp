@@ -1088,10 +1088,10 @@ Blitter::exec()
     }
     
     // Allocate the bus if needed
-    if (bus && !agnus.allocateBus<BUS_BLITTER>()) return;
+    if (bus && !agnus.allocateBus<BUS_BLITTER>()) { waitForBus(); return; }
 
     // Check if the Blitter needs a free bus to continue
-    if (busidle && !agnus.busIsFree<BUS_BLITTER>()) return;
+    if (busidle && !agnus.busIsFree<BUS_BLITTER>()) { waitForBus(); return; }
 
     bltpc++;
 
@@ -1258,10 +1258,10 @@ Blitter::fakeExec()
     }
 
     // Allocate the bus if needed
-    if (bus && !agnus.allocateBus<BUS_BLITTER>()) return;
+    if (bus && !agnus.allocateBus<BUS_BLITTER>()) { waitForBus(); return; }
 
     // Check if the Blitter needs a free bus to continue
-    if (busidle && !agnus.busIsFree<BUS_BLITTER>()) return;
+    if (busidle && !agnus.busIsFree<BUS_BLITTER>()) { waitForBus(); return; }
 
     bltpc++;
 
@@ -1351,10 +1351,10 @@ Blitter::execLine()
     }
     
     // Allocate the bus if needed
-    if (bus && !agnus.allocateBus<BUS_BLITTER>()) return;
+    if (bus && !agnus.allocateBus<BUS_BLITTER>()) { waitForBus(); return; }
 
     // Check if the Blitter needs a free bus to continue
-    if (busidle && !agnus.busIsFree<BUS_BLITTER>()) return;
+    if (busidle && !agnus.busIsFree<BUS_BLITTER>()) { waitForBus(); return; }
 
     bltpc++;
 
@@ -1465,10 +1465,10 @@ Blitter::fakeExecLine()
     }
     
     // Allocate the bus if needed
-    if (bus && !agnus.allocateBus<BUS_BLITTER>()) return;
+    if (bus && !agnus.allocateBus<BUS_BLITTER>()) { waitForBus(); return; }
 
     // Check if the Blitter needs a free bus to continue
-    if (busidle && !agnus.busIsFree<BUS_BLITTER>()) return;
+    if (busidle && !agnus.busIsFree<BUS_BLITTER>()) { waitForBus(); return; }
 
     bltpc++;
 
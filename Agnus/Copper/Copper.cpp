@@ -120,6 +120,44 @@ Copper::findHorizontalMatch(u32 &match, u32 comp, u32 mask) const
     return false;
 }
 
+bool
+Copper::findMatchCached(Beam &match)
+{
+    if constexpr (NO_COP_CACHE) return findMatch(match);
+
+    u32 start = (u32)(agnus.pos.v << 8 | agnus.pos.h);
+    isize numLines = agnus.frame.numLines();
+    auto &entry = wakeupCache[(coppc0 >> 2) & (wakeupCacheSize - 1)];
+
+    // Check if the wakeup position has been computed before
+    if (entry.addr == coppc0 &&
+        entry.ins1 == cop1ins &&
+        entry.ins2 == cop2ins &&
+        entry.start == start &&
+        entry.numLines == numLines) {
+
+        cacheHits++;
+        if (entry.trigger < 0) return false;
+
+        match.v = entry.trigger >> 8;
+        match.h = entry.trigger & 0xFF;
+        return true;
+    }
+
+    // Compute the wakeup position and store it in the cache
+    cacheMisses++;
+    bool result = findMatch(match);
+
+    entry.addr = coppc0;
+    entry.ins1 = cop1ins;
+    entry.ins2 = cop2ins;
+    entry.start = start;
+    entry.numLines = numLines;
+    entry.trigger = result ? i32(match.v << 8 | match.h) : -1;
+
+    return result;
+}
+
 void
 Copper::move(u32 addr, u16 value)
 {
@@ -189,7 +227,7 @@ Copper::scheduleWaitWakeup(bool bfd)
     Beam trigger;
 
     // Find the trigger position for this WAIT command
-    if (findMatch(trigger)) {
+    if (findMatchCached(trigger)) {
 
         // In how many cycles do we get there?
         isize delay = trigger - agnus.pos;
@@ -20,6 +20,7 @@
 class Copper : public SubComponent
 {
     friend class Agnus;
+    template <class...> friend class SyncHooks;
     friend class CopperDebugger;
     
 public:
@@ -91,6 +92,42 @@ private:
     u32 checksum = util::fnv_1a_init32();
 
 
+    //
+    // Caching
+    //
+
+private:
+
+    /* Cache of precomputed WAIT wakeup positions. If the Copper list does not
+     * change, the same WAIT instruction is usually reached at the same beam
+     * position in every frame. An entry is used only if the instruction
+     * address, both instruction words, the start position and the frame
+     * length match. Hence, it never alters the emulation result, even if the
+     * CPU or the Blitter modify the list in the middle of a frame.
+     *
+     * The cache only replaces the beam position search in findMatch(). Each
+     * instruction is still fetched and executed in its own DMA cycle, and the
+     * number of scheduled Copper events remains the same.
+     */
+    struct WakeupEntry {
+
+        u32 addr;
+        u16 ins1;
+        u16 ins2;
+        u32 start;
+        isize numLines;
+
+        // Wakeup position (-1 if the Copper does not wake up in this frame)
+        i32 trigger;
+    };
+    static constexpr isize wakeupCacheSize = 256;
+    WakeupEntry wakeupCache[wakeupCacheSize] = { };
+
+    // Cache statistics
+    i64 cacheHits = 0;
+    i64 cacheMisses = 0;
+
+
     //
     // Initializing
     //
@@ -206,6 +243,9 @@ private:
      */
     bool findMatch(Beam &result) const;
 
+    // Cached version of findMatch()
+    bool findMatchCached(Beam &result);
+
     // Called by findMatch() to determine the horizontal trigger position
     bool findHorizontalMatch(u32 &beam, u32 comp, u32 mask) const;
 
@@ -305,6 +345,9 @@ public:
     // Reschedules the current Copper event
     void reschedule(int delay = 1);
 
+    // Reschedules the current Copper event to the next usable bus cycle
+    void waitForBus();
+
 private:
     
     // Executed after each frame
@@ -32,7 +32,7 @@ Copper::serviceEvent(EventID id)
             trace(COP_DEBUG && verbose, "COP_REQ_DMA\n");
             
             // Wait for the next possible DMA cycle
-            if (!agnus.busIsFree<BUS_COPPER>()) { reschedule(); break; }
+            if (!agnus.busIsFree<BUS_COPPER>()) { waitForBus(); break; }
 
             // Don't wake up in an odd cycle
             if (IS_ODD(agnus.pos.h)) { reschedule(); break; }
@@ -46,7 +46,7 @@ Copper::serviceEvent(EventID id)
             trace(COP_DEBUG && verbose, "COP_WAKEUP\n");
             
             // Wait for the next possible DMA cycle
-            if (!agnus.busIsFree<BUS_COPPER>()) { reschedule(); break; }
+            if (!agnus.busIsFree<BUS_COPPER>()) { waitForBus(); break; }
             
             // Don't wake up in an odd cycle
             if (IS_ODD(agnus.pos.h)) { reschedule(); break; }
@@ -80,7 +80,7 @@ Copper::serviceEvent(EventID id)
             trace(COP_DEBUG && verbose, "COP_FETCH\n");
 
             // Wait for the next possible DMA cycle
-            if (!agnus.busIsFree<BUS_COPPER>()) { reschedule(); break; }
+            if (!agnus.busIsFree<BUS_COPPER>()) { waitForBus(); break; }
 
             // Remember the program counter (picked up by the debugger)
             coppc0 = coppc;
@@ -103,7 +103,7 @@ Copper::serviceEvent(EventID id)
             trace(COP_DEBUG && verbose, "COP_MOVE\n");
 
             // Wait for the next possible DMA cycle
-            if (!agnus.busIsFree<BUS_COPPER>()) { reschedule(); break; }
+            if (!agnus.busIsFree<BUS_COPPER>()) { waitForBus(); break; }
 
             // Load the second instruction word
             cop2ins = agnus.doCopperDmaRead(coppc);
@@ -141,7 +141,7 @@ Copper::serviceEvent(EventID id)
         case COP_WAIT_OR_SKIP:
 
             // Wait for the next possible DMA cycle
-            if (!agnus.busIsFree<BUS_COPPER>()) { reschedule(); break; }
+            if (!agnus.busIsFree<BUS_COPPER>()) { waitForBus(); break; }
 
             // Load the second instruction word
             cop2ins = agnus.doCopperDmaRead(coppc);
@@ -158,7 +158,7 @@ Copper::serviceEvent(EventID id)
             trace(COP_DEBUG && verbose, "COP_WAIT1\n");
 
             // Wait for the next possible DMA cycle
-            if (!agnus.busIsFree<BUS_COPPER>()) { reschedule(); break; }
+            if (!agnus.busIsFree<BUS_COPPER>()) { waitForBus(); break; }
 
             // Schedule next state
             schedule(COP_WAIT2);
@@ -207,7 +207,7 @@ Copper::serviceEvent(EventID id)
             trace(COP_DEBUG && verbose, "COP_SKIP1\n");
 
             // Wait for the next possible DMA cycle
-            if (!agnus.busIsFree<BUS_COPPER>()) { reschedule(); break; }
+            if (!agnus.busIsFree<BUS_COPPER>()) { waitForBus(); break; }
 
             // Schedule next state
             schedule(COP_SKIP2);
@@ -218,7 +218,7 @@ Copper::serviceEvent(EventID id)
             trace(COP_DEBUG && verbose, "COP_SKIP2\n");
 
             // Wait for the next possible DMA cycle
-            if (!agnus.busIsFree<BUS_COPPER>()) { reschedule(); break; }
+            if (!agnus.busIsFree<BUS_COPPER>()) { waitForBus(); break; }
 
             // Test 'coptim3' suggests that cycle $E1 is blocked in this state
             if (agnus.pos.h == 0xE1) { reschedule(); break; }
@@ -253,7 +253,7 @@ Copper::serviceEvent(EventID id)
         case COP_JMP2:
 
             // Wait for the next possible DMA cycle
-            if (!agnus.busIsFree<BUS_COPPER>()) { reschedule(); break; }
+            if (!agnus.busIsFree<BUS_COPPER>()) { waitForBus(); break; }
 
             switchToCopperList((isize)scheduler.data[SLOT_COP]);
             schedule(COP_FETCH);
@@ -288,3 +288,9 @@ Copper::reschedule(int delay)
 {
     agnus.rescheduleRel<SLOT_COP>(DMA_CYCLES(delay));
 }
+
+void
+Copper::waitForBus()
+{
+    scheduler.rescheduleAbs<SLOT_COP>(agnus.nextBusCycle());
+}
@@ -23,6 +23,8 @@ Copper::_dump(dump::Category category, std::ostream& os) const
         os << dec(copList) << std::endl;
         os << tab("Skip flag");
         os << bol(skip) << std::endl;
+        os << tab("Wakeup cache");
+        os << dec(cacheHits) << " hits, " << dec(cacheMisses) << " misses" << std::endl;
     }
     
     if (category & dump::Registers) {
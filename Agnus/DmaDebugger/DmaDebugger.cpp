@@ -10,14 +10,27 @@
 #include "config.h"
 #include "DmaDebugger.h"
 #include "Agnus.h"
+#include "Amiga.h"
 #include "Denise.h"
 #include "MsgQueue.h"
 #include "PixelEngine.h"
+#include <algorithm>
+#include <fstream>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 DmaDebugger::DmaDebugger(Amiga &ref) : SubComponent(ref)
 {
 }
 
+DmaDebugger::~DmaDebugger()
+{
+    delete recording[0];
+    delete recording[1];
+}
+
 DmaDebuggerConfig
 DmaDebugger::getDefaultConfig()
 {
@@ -111,11 +124,13 @@ DmaDebugger::setConfigItem(Option option, i64 value)
             }
             
             config.displayMode = (DmaDisplayMode)value;
+            updateWeights();
             return;
 
         case OPT_DMA_DEBUG_OPACITY:
                         
             config.opacity = (isize)value;
+            updateWeights();
             return;
 
         default:
@@ -313,51 +328,54 @@ DmaDebugger::setColor(BusOwner owner, u32 rgba)
                           
     // Compute the color variants used for drawing
     RgbColor color = RgbColor(rgba);
-    debugColor[owner][0] = color.shade(0.3);
-    debugColor[owner][1] = color.shade(0.1);
-    debugColor[owner][2] = color.tint(0.1);
-    debugColor[owner][3] = color.tint(0.3);
+    debugColor[owner][0] = GpuColor(color.shade(0.3)).rawValue;
+    debugColor[owner][1] = GpuColor(color.shade(0.1)).rawValue;
+    debugColor[owner][2] = GpuColor(color.tint(0.1)).rawValue;
+    debugColor[owner][3] = GpuColor(color.tint(0.3)).rawValue;
 }
 
 void
-DmaDebugger::computeOverlay()
+DmaDebugger::updateWeights()
 {
-    // Only proceed if DMA debugging has been turned on
-    if (!config.enabled) return;
-
-    BusOwner *owners = agnus.busOwner;
-    u16 *values = agnus.busValue;
-    u32 *ptr = denise.pixelEngine.pixelAddr(0);
-
-    double opacity = config.opacity / 100.0;
-    double bgWeight = 0;
-    double fgWeight = 0;
+    auto opacity = std::clamp(config.opacity, isize(0), isize(100));
+    auto scaled = [](isize percent) { return u16((percent * 256 + 50) / 100); };
 
     switch (config.displayMode) {
 
         case DMA_DISPLAY_MODE_FG_LAYER:
 
-            bgWeight = 0.0;
-            fgWeight = 1.0 - opacity;
+            pixelWeight = scaled(100 - opacity);
+            shadeWeight = 256;
             break;
 
         case DMA_DISPLAY_MODE_BG_LAYER:
 
-            bgWeight = 1.0 - opacity;
-            fgWeight = 0.0;
+            pixelWeight = 0;
+            shadeWeight = 256 - scaled(100 - opacity);
             break;
 
         case DMA_DISPLAY_MODE_ODD_EVEN_LAYERS:
 
-            bgWeight = opacity;
-            fgWeight = 1.0 - opacity;
+            pixelWeight = scaled(100 - opacity);
+            shadeWeight = 256 - scaled(opacity);
             break;
 
         default:
             fatalError;
-
     }
 
+    colorWeight = 256 - pixelWeight;
+}
+
+void
+DmaDebugger::computeOverlay()
+{
+    assert(config.enabled);
+
+    BusOwner *owners = agnus.busOwner;
+    u16 *values = agnus.busValue;
+    u32 *ptr = denise.pixelEngine.pixelAddr(0);
+
     for (isize i = 0; i < HPOS_CNT; i++, ptr += 4) {
 
         BusOwner owner = owners[i];
@@ -365,38 +383,106 @@ DmaDebugger::computeOverlay()
         // Handle the easy case first: No foreground pixels
         if (!visualize[owner]) {
 
-            if (bgWeight != 0.0) {
-                ptr[0] = GpuColor(ptr[0]).shade(bgWeight).rawValue;
-                ptr[1] = GpuColor(ptr[1]).shade(bgWeight).rawValue;
-                ptr[2] = GpuColor(ptr[2]).shade(bgWeight).rawValue;
-                ptr[3] = GpuColor(ptr[3]).shade(bgWeight).rawValue;
-            }
+            if (shadeWeight != 256) shade(ptr);
             continue;
         }
 
         // Get RGBA values of foreground pixels
-        GpuColor col0 = debugColor[owner][(values[i] & 0xC000) >> 14];
-        GpuColor col1 = debugColor[owner][(values[i] & 0x0C00) >> 10];
-        GpuColor col2 = debugColor[owner][(values[i] & 0x00C0) >> 6];
-        GpuColor col3 = debugColor[owner][(values[i] & 0x000C) >> 2];
-
-        if (fgWeight != 0.0) {
-            col0 = col0.mix(GpuColor(ptr[0]), fgWeight);
-            col1 = col1.mix(GpuColor(ptr[1]), fgWeight);
-            col2 = col2.mix(GpuColor(ptr[2]), fgWeight);
-            col3 = col3.mix(GpuColor(ptr[3]), fgWeight);
-        }
+        u32 col[4] = {
+
+            debugColor[owner][(values[i] & 0xC000) >> 14],
+            debugColor[owner][(values[i] & 0x0C00) >> 10],
+            debugColor[owner][(values[i] & 0x00C0) >> 6],
+            debugColor[owner][(values[i] & 0x000C) >> 2]
+        };
+
+        blend(ptr, col);
+    }
+}
+
+void
+DmaDebugger::blend(u32 *ptr, const u32 *color) const
+{
+#if defined(__SSE2__)
+
+    if constexpr (!NO_SSE) {
+
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+        const __m128i wc = _mm_set1_epi16((short)colorWeight);
+        const __m128i wp = _mm_set1_epi16((short)pixelWeight);
+
+        __m128i c = _mm_loadu_si128((__m128i *)color);
+        __m128i p = _mm_loadu_si128((__m128i *)ptr);
+
+        // Blend all channels of the four pixels with 16 bit precision
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(c, zero), wc),
+                                   _mm_mullo_epi16(_mm_unpacklo_epi8(p, zero), wp));
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(c, zero), wc),
+                                   _mm_mullo_epi16(_mm_unpackhi_epi8(p, zero), wp));
+
+        lo = _mm_srli_epi16(lo, 8);
+        hi = _mm_srli_epi16(hi, 8);
+
+        _mm_storeu_si128((__m128i *)ptr, _mm_or_si128(_mm_packus_epi16(lo, hi), alpha));
+        return;
+    }
+
+#endif
+
+    // Blend two channels at once
+    for (isize i = 0; i < 4; i++) {
+
+        u32 c = color[i], p = ptr[i];
+        u32 rb = ((c & 0xFF00FF) * colorWeight + (p & 0xFF00FF) * pixelWeight) >> 8;
+        u32 g = ((c & 0x00FF00) * colorWeight + (p & 0x00FF00) * pixelWeight) >> 8;
+        ptr[i] = 0xFF000000 | (rb & 0xFF00FF) | (g & 0x00FF00);
+    }
+}
+
+void
+DmaDebugger::shade(u32 *ptr) const
+{
+#if defined(__SSE2__)
+
+    if constexpr (!NO_SSE) {
+
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i alpha = _mm_set1_epi32((int)0xFF000000);
+        const __m128i ws = _mm_set1_epi16((short)shadeWeight);
+
+        __m128i p = _mm_loadu_si128((__m128i *)ptr);
+
+        __m128i lo = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(p, zero), ws), 8);
+        __m128i hi = _mm_srli_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(p, zero), ws), 8);
+
+        _mm_storeu_si128((__m128i *)ptr, _mm_or_si128(_mm_packus_epi16(lo, hi), alpha));
+        return;
+    }
+
+#endif
 
-        ptr[0] = col0.rawValue;
-        ptr[1] = col1.rawValue;
-        ptr[2] = col2.rawValue;
-        ptr[3] = col3.rawValue;
+    for (isize i = 0; i < 4; i++) {
+
+        u32 p = ptr[i];
+        u32 rb = ((p & 0xFF00FF) * shadeWeight) >> 8;
+        u32 g = ((p & 0x00FF00) * shadeWeight) >> 8;
+        ptr[i] = 0xFF000000 | (rb & 0xFF00FF) | (g & 0x00FF00);
     }
 }
 
 void
 DmaDebugger::vSyncHandler()
 {
+    // Hand over the recorded frame
+    if (recording[0]) {
+
+        SYNCHRONIZED
+
+        std::swap(recording[0], recording[1]);
+        recording[0]->numLines = 0;
+    }
+
     // Only proceed if the debugger is enabled
     if (!config.enabled) return;
 
@@ -408,3 +494,95 @@ DmaDebugger::vSyncHandler()
         }
     }
 }
+
+void
+DmaDebugger::startRecording()
+{
+    SUSPENDED
+
+    if (!recording[0]) {
+
+        recording[0] = new BusRecording();
+        recording[1] = new BusRecording();
+    }
+}
+
+void
+DmaDebugger::stopRecording()
+{
+    SUSPENDED
+
+    delete recording[0];
+    delete recording[1];
+    recording[0] = recording[1] = nullptr;
+}
+
+void
+DmaDebugger::recordLine(isize line)
+{
+    assert(recording[0]);
+
+    if (line < VPOS_CNT) {
+
+        std::memcpy(recording[0]->owner[line], agnus.busOwner, sizeof(agnus.busOwner));
+        std::memcpy(recording[0]->value[line], agnus.busValue, sizeof(agnus.busValue));
+        recording[0]->numLines = line + 1;
+    }
+}
+
+void
+DmaDebugger::hsyncHandler()
+{
+    if (isRecording()) recordLine(agnus.pos.v);
+}
+
+isize
+DmaDebugger::recordedLines() const
+{
+    return recording[1] ? recording[1]->numLines : 0;
+}
+
+const BusOwner *
+DmaDebugger::recordedOwners(isize line) const
+{
+    assert(line >= 0 && line < recordedLines());
+    return recording[1]->owner[line];
+}
+
+const u16 *
+DmaDebugger::recordedValues(isize line) const
+{
+    assert(line >= 0 && line < recordedLines());
+    return recording[1]->value[line];
+}
+
+void
+DmaDebugger::saveRecording(const string &path) const
+{
+    SYNCHRONIZED
+
+    std::ofstream stream(path, std::ofstream::binary);
+    if (!stream.is_open()) throw VAError(ERROR_FILE_CANT_WRITE, path);
+
+    /* File format: A header with the number of lines and the number of DMA
+     * cycles per line (big endian), followed by the bus owners (one byte per
+     * cycle) and the bus values (two bytes per cycle, big endian) of each line.
+     */
+    isize lines = recordedLines();
+    u8 header[] = { 'D', 'M', 'A', 0, BYTE1(lines), BYTE0(lines), 0, HPOS_CNT };
+    stream.write((const char *)header, sizeof(header));
+
+    for (isize v = 0; v < lines; v++) {
+
+        u8 buffer[3 * HPOS_CNT];
+        for (isize h = 0; h < HPOS_CNT; h++) {
+
+            buffer[h] = (u8)recording[1]->owner[v][h];
+            buffer[HPOS_CNT + 2 * h] = HI_BYTE(recording[1]->value[v][h]);
+            buffer[HPOS_CNT + 2 * h + 1] = LO_BYTE(recording[1]->value[v][h]);
+        }
+        stream.write((const char *)buffer, sizeof(buffer));
+    }
+
+    if (!stream.good()) throw VAError(ERROR_FILE_CANT_WRITE, path);
+}
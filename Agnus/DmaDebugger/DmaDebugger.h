@@ -12,6 +12,7 @@
 #include "DmaDebuggerTypes.h"
 #include "SubComponent.h"
 #include "Colors.h"
+#include "Constants.h"
 
 class DmaDebugger : public SubComponent {
 
@@ -22,7 +23,29 @@ class DmaDebugger : public SubComponent {
     bool visualize[BUS_COUNT] = {};
     
     // Colors used for highlighting DMA (derived from config.debugColor)
-    RgbColor debugColor[BUS_COUNT][5] = {};
+    u32 debugColor[BUS_COUNT][4] = {};
+
+    /* Fixed-point blending weights (derived from config.displayMode and
+     * config.opacity). The first two weights are used to mix a debug color
+     * with the pixel underneath. The third weight is used to shade pixels in
+     * cycles that are not visualized. All weights are scaled by 256.
+     */
+    u16 colorWeight = 256;
+    u16 pixelWeight = 0;
+    u16 shadeWeight = 256;
+
+    /* Recorded bus usage. If recording is on, the contents of the busOwner and
+     * busValue arrays are saved at the end of each rasterline. The first
+     * buffer collects the data of the current frame and the second buffer
+     * keeps the data of the most recently completed frame.
+     */
+    struct BusRecording {
+
+        BusOwner owner[VPOS_CNT][HPOS_CNT];
+        u16 value[VPOS_CNT][HPOS_CNT];
+        isize numLines;
+    };
+    BusRecording *recording[2] = { };
 
 
     //
@@ -32,6 +55,7 @@ class DmaDebugger : public SubComponent {
 public:
 
     DmaDebugger(Amiga &ref);
+    ~DmaDebugger();
 
     
     //
@@ -72,6 +96,7 @@ private:
 
     void getColor(DmaChannel channel, double *rgb);
     void setColor(BusOwner owner, u32 rgba);
+    void updateWeights();
 
     
     //
@@ -101,10 +126,45 @@ private:
     //
 
 public:
-    
+
+    // Checks if the debug output needs to be superimposed
+    bool isEnabled() const { return config.enabled; }
+
     // Superimposes the debug output onto the current rasterline
     void computeOverlay();
 
     // Cleans up some texture data at the end of each frame
     void vSyncHandler();
+
+private:
+
+    void blend(u32 *ptr, const u32 *color) const;
+    void shade(u32 *ptr) const;
+
+
+    //
+    // Recording bus usage
+    //
+
+public:
+
+    // Starts or stops recording
+    void startRecording();
+    void stopRecording();
+    bool isRecording() const { return recording[0] != nullptr; }
+
+    // Saves the bus usage of the current rasterline
+    void recordLine(isize line);
+
+    // Called at the end of each rasterline
+    bool hsyncIdle() const { return NO_DMA_DEBUGGER || !isRecording(); }
+    void hsyncHandler();
+
+    // Provides the recorded data of the most recently completed frame
+    isize recordedLines() const;
+    const BusOwner *recordedOwners(isize line) const;
+    const u16 *recordedValues(isize line) const;
+
+    // Writes the most recently completed frame to a file
+    void saveRecording(const string &path) const throws;
 };
@@ -117,6 +117,10 @@ static constexpr usize UPDATE_DAS_TABLE     = 0b100;
 class Sequencer : public SubComponent
 {
     friend class Agnus;
+    template <class...> friend class SyncHooks;
+
+    // Result of the latest inspection
+    mutable SequencerInfo info = {};
     
     //
     // Event tables
@@ -142,6 +146,13 @@ public:
     // Jump tables connecting the scheduled events
     u8 nextBplEvent[HPOS_CNT];
     u8 nextDasEvent[HPOS_CNT];
+
+    /* Jump table pointing to the next cycle without bitplane DMA. It is used
+     * by the Copper and the Blitter to skip all cycles in which the bus is
+     * occupied by bitplane DMA. The table is derived from bplEvent[] and
+     * not stored in snapshots.
+     */
+    u8 nextBplGap[HPOS_CNT];
     
     
     //
@@ -186,6 +197,55 @@ public:
     // Signals controlling the bitplane display logic
     SigRecorder sigRecorder;
 
+
+    //
+    // Event table cache
+    //
+
+private:
+
+    /* Split-screen effects cause the bitplane event table to be recomputed in
+     * many lines of a frame, although they usually switch between a small
+     * number of display setups. Because the computed tables only depend on the
+     * recorded signals, the initial DDF state, BPLCON0, the scroll values, and
+     * the layout of the fetch unit, they are memoized in a small cache.
+     */
+    static constexpr isize bplCacheSize = 16;
+    static constexpr isize bplCacheSignals = 16;
+
+    struct BplCacheKey {
+
+        u8 ecs;
+        u8 modified;
+        u8 scroll;
+        u8 count;
+        DDFState state;
+        EventID fetch[2][8];
+        u8 triggers[bplCacheSignals];
+        u16 signals[bplCacheSignals];
+    };
+
+    struct BplCacheEntry {
+
+        bool valid;
+        BplCacheKey key;
+
+        // Computed tables
+        EventID bplEvent[HPOS_CNT];
+        u8 nextBplEvent[HPOS_CNT];
+        u8 nextBplGap[HPOS_CNT];
+
+        // Side effects
+        EventID fetch[2][8];
+        DDFState state;
+        bool unblank;
+    };
+    BplCacheEntry bplCache[bplCacheSize] = { };
+
+    // Cache statistics
+    i64 bplCacheHits = 0;
+    i64 bplCacheMisses = 0;
+
     
     //
     // Execution control
@@ -227,6 +287,7 @@ private:
     private:
 
     void _reset(bool hard) override;
+    void _inspect() const override;
 
     template <class T>
     void applyToPersistentItems(T& worker)
@@ -267,8 +328,19 @@ private:
     u64 _checksum() override { COMPUTE_SNAPSHOT_CHECKSUM }
     isize _load(const u8 *buffer) override { LOAD_SNAPSHOT_ITEMS }
     isize _save(u8 *buffer) override { SAVE_SNAPSHOT_ITEMS }
+    isize didLoadFromBuffer(const u8 *buffer) override { updateBplJumpTable(); return 0; }
 
     
+    //
+    // Analyzing
+    //
+
+public:
+
+    // Returns the result of the latest inspection
+    SequencerInfo getInfo() const { return AmigaComponent::getInfo(info); }
+
+
     //
     // Accessing registers (SequencerRegs.cpp)
     //
@@ -306,6 +378,12 @@ private:
     
     // Recomputes the BPL event table
     template <bool ecs> void computeBplEventTable(const SigRecorder &sr);
+    template <bool ecs> void computeBplEventTable(const SigRecorder &sr, DDFState &state);
+
+    // Sets up the lookup key for the event table cache
+    template <bool ecs> bool makeBplCacheKey(const SigRecorder &sr,
+                                             const DDFState &state,
+                                             BplCacheKey &key) const;
     template <bool ecs> void computeBplEventsSlow(const SigRecorder &sr, DDFState &state);
     template <bool ecs> void computeBplEventsFast(const SigRecorder &sr, DDFState &state);
     template <bool ecs> void computeBplEvents(isize strt, isize stop, DDFState &state);
@@ -10,15 +10,17 @@
 #include "config.h"
 #include "Sequencer.h"
 #include "Agnus.h"
+#include "Checksum.h"
+#include <cstring>
 
 void
 Sequencer::initBplEvents()
 {
     for (isize i = 0; i < HPOS_MAX; i++) bplEvent[i] = EVENT_NONE;
-    for (isize i = 0; i < HPOS_MAX; i++) nextBplEvent[i] = HPOS_MAX;
-    
     bplEvent[HPOS_MAX] = BPL_EOL;
-    nextBplEvent[HPOS_MAX] = 0;
+
+    // Setup the jump tables (nextBplEvent and nextBplGap)
+    updateBplJumpTable();
 }
 
 void
@@ -53,7 +55,67 @@ Sequencer::computeBplEventTable(const SigRecorder &sr)
     
     // Evaluate the current state of the vertical DIW flipflop
     if (!state.bpv) { state.bprun = false; state.cnt = 0; }
+
+    BplCacheKey key = { };
+
+    if (!makeBplCacheKey <ecs> (sr, state, key)) {
+
+        // The table can't be cached
+        computeBplEventTable <ecs> (sr, state);
+
+    } else {
+
+        auto hash = util::fnv_1a_32((const u8 *)&key, sizeof(key));
+        auto &entry = bplCache[hash & (bplCacheSize - 1)];
+
+        if (entry.valid && std::memcmp(&entry.key, &key, sizeof(key)) == 0) {
+
+            // Reuse the cached tables
+            std::memcpy(bplEvent, entry.bplEvent, sizeof(bplEvent));
+            std::memcpy(nextBplEvent, entry.nextBplEvent, sizeof(nextBplEvent));
+            std::memcpy(nextBplGap, entry.nextBplGap, sizeof(nextBplGap));
+            std::memcpy(fetch, entry.fetch, sizeof(fetch));
+            if (entry.unblank) lineIsBlank = false;
+            state = entry.state;
+            bplCacheHits++;
+
+        } else {
+
+            // Compute the tables and store them in the cache
+            auto blank = lineIsBlank;
+            lineIsBlank = true;
+            computeBplEventTable <ecs> (sr, state);
+
+            entry.valid = true;
+            entry.key = key;
+            std::memcpy(entry.bplEvent, bplEvent, sizeof(bplEvent));
+            std::memcpy(entry.nextBplEvent, nextBplEvent, sizeof(nextBplEvent));
+            std::memcpy(entry.nextBplGap, nextBplGap, sizeof(nextBplGap));
+            std::memcpy(entry.fetch, fetch, sizeof(fetch));
+            entry.unblank = !lineIsBlank;
+            entry.state = state;
+            lineIsBlank &= blank;
+            bplCacheMisses++;
+        }
+    }
+
+    // Rectify the currently scheduled event
+    agnus.scheduleBplEventForCycle(agnus.pos.h);
     
+    // Write back the new ddf state
+    ddf = state;
+
+    // Check if we need to recompute all events in the next scanline
+    if (state != ddfInitial) {
+     
+        trace(SEQ_DEBUG, "Recompute table in next line\n");
+        hsyncActions |= UPDATE_BPL_TABLE;
+    }
+}
+
+template <bool ecs> void
+Sequencer::computeBplEventTable(const SigRecorder &sr, DDFState &state)
+{
     // Fill the event table
     if (!sr.modified && (!state.bpv || !state.bmapen)) {
         computeBplEventsFast <ecs> (sr, state);
@@ -66,19 +128,30 @@ Sequencer::computeBplEventTable(const SigRecorder &sr)
                             
     // Update the jump table
     updateBplJumpTable();
+}
 
-    // Rectify the currently scheduled event
-    agnus.scheduleBplEventForCycle(agnus.pos.h);
-    
-    // Write back the new ddf state
-    ddf = state;
+template <bool ecs> bool
+Sequencer::makeBplCacheKey(const SigRecorder &sr, const DDFState &state, BplCacheKey &key) const
+{
+    static_assert(sizeof(BplCacheKey) == 4 + sizeof(DDFState) + 16 + 3 * bplCacheSignals,
+                  "BplCacheKey must not contain padding bytes");
 
-    // Check if we need to recompute all events in the next scanline
-    if (state != ddfInitial) {
-     
-        trace(SEQ_DEBUG, "Recompute table in next line\n");
-        hsyncActions |= UPDATE_BPL_TABLE;
+    if (NO_BPL_CACHE || sr.count() > bplCacheSignals) return false;
+
+    key.ecs = ecs;
+    key.modified = sr.modified;
+    key.scroll = (u8)(agnus.scrollOdd | agnus.scrollEven << 4);
+    key.count = (u8)sr.count();
+    key.state = state;
+    std::memcpy(key.fetch, fetch, sizeof(fetch));
+
+    for (isize i = 0; i < sr.count(); i++) {
+
+        key.triggers[i] = (u8)sr.keys[i];
+        key.signals[i] = sr.elements[i];
     }
+
+    return true;
 }
 
 template <bool ecs> void
@@ -392,11 +465,14 @@ void
 Sequencer::updateBplJumpTable()
 {
     u8 next = 0;
+    u8 gap = HPOS_CNT;
     
     for (isize i = HPOS_MAX; i >= 0; i--) {
         
         nextBplEvent[i] = next;
+        nextBplGap[i] = gap;
         if (bplEvent[i]) next = (i8)i;
+        if (!isBplFetch(bplEvent[i])) gap = (u8)i;
     }
 }
 
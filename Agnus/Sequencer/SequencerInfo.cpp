@@ -39,6 +39,8 @@ Sequencer::_dump(dump::Category category, std::ostream& os) const
         os << hex(ddf.bmctl) << " (" << hex(ddfInitial.bmctl) << ")" << std::endl;
         os << tab("CNT");
         os << dec(ddf.cnt) << " (" << dec(ddfInitial.cnt) << ")" << std::endl;
+        os << tab("Event table cache");
+        os << dec(bplCacheHits) << " hits, " << dec(bplCacheMisses) << " misses" << std::endl;
     }
         
     if (category & dump::Registers) {
@@ -130,3 +132,18 @@ Sequencer::_dump(dump::Category category, std::ostream& os) const
         }
     }
 }
+
+void
+Sequencer::_inspect() const
+{
+    SYNCHRONIZED
+
+    info.ddfstrt = ddfstrt;
+    info.ddfstop = ddfstop;
+    info.diwstrt = diwstrt;
+    info.diwstop = diwstop;
+    info.vstrt = vstrt;
+    info.vstop = vstop;
+    info.bplCacheHits = bplCacheHits;
+    info.bplCacheMisses = bplCacheMisses;
+}
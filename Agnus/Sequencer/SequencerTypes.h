@@ -91,3 +91,21 @@ struct DDFState
 };
 
 #endif
+
+
+//
+// Structures
+//
+
+typedef struct
+{
+    u16   ddfstrt;
+    u16   ddfstop;
+    u16   diwstrt;
+    u16   diwstop;
+    isize vstrt;
+    isize vstop;
+    i64   bplCacheHits;
+    i64   bplCacheMisses;
+}
+SequencerInfo;
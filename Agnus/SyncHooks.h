@@ -0,0 +1,71 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include <tuple>
+
+/* This class notifies a fixed set of components about the end of a rasterline
+ * or a frame. A component subscribes by appearing in the template argument
+ * list. It then has to provide the handler that is called:
+ *
+ *     void hsyncHandler();     (called by hsync())
+ *     void vsyncHandler();     (called by vsync())
+ *
+ * Optionally, a component may provide a fast path check:
+ *
+ *     bool hsyncIdle() const;  (checked by hsync())
+ *     bool vsyncIdle() const;  (checked by vsync())
+ *
+ * If the function returns true, the handler is skipped. Hence, it must only
+ * return true if the handler would not change anything. Handlers need to stay
+ * correct if they are called in the idle state, because the fast paths can
+ * be bypassed for benchmarking.
+ *
+ * All subscribers are known at compile time. The handlers are called directly
+ * and can be inlined. No function pointers or virtual functions are involved.
+ */
+template <class... Subscribers>
+class SyncHooks {
+
+    // The subscribed components
+    std::tuple<Subscribers &...> subscribers;
+
+public:
+
+    SyncHooks(Subscribers &... s) : subscribers(s...) { }
+
+    // Notifies all subscribers about the end of the current line
+    template <bool fastPath = true> void hsync() {
+        std::apply([](auto &... s) { (hsync<fastPath>(s), ...); }, subscribers);
+    }
+
+    // Notifies all subscribers about the end of the current frame
+    template <bool fastPath = true> void vsync() {
+        std::apply([](auto &... s) { (vsync<fastPath>(s), ...); }, subscribers);
+    }
+
+private:
+
+    template <bool fastPath, class T> static void hsync(T &s) {
+
+        if constexpr (fastPath && requires { s.hsyncIdle(); }) {
+            if (s.hsyncIdle()) return;
+        }
+        s.hsyncHandler();
+    }
+
+    template <bool fastPath, class T> static void vsync(T &s) {
+
+        if constexpr (fastPath && requires { s.vsyncIdle(); }) {
+            if (s.vsyncIdle()) return;
+        }
+        s.vsyncHandler();
+    }
+};
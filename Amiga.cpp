@@ -174,6 +174,9 @@ Amiga::getConfigItem(Option option) const
         case OPT_CLX_SPR_SPR:
         case OPT_CLX_SPR_PLF:
         case OPT_CLX_PLF_PLF:
+        case OPT_FRAME_SKIP:
+        case OPT_FRAME_SKIP_INTERVAL:
+        case OPT_WARP_FRAME_SKIP:
             
             return denise.getConfigItem(option);
             
@@ -181,6 +184,8 @@ Amiga::getConfigItem(Option option) const
         case OPT_BRIGHTNESS:
         case OPT_CONTRAST:
         case OPT_SATURATION:
+        case OPT_FRAME_FORMAT:
+        case OPT_RENDER_THREAD:
             
             return denise.pixelEngine.getConfigItem(option);
             
@@ -351,6 +356,9 @@ Amiga::configure(Option option, i64 value)
         case OPT_CLX_SPR_SPR:
         case OPT_CLX_SPR_PLF:
         case OPT_CLX_PLF_PLF:
+        case OPT_FRAME_SKIP:
+        case OPT_FRAME_SKIP_INTERVAL:
+        case OPT_WARP_FRAME_SKIP:
             
             denise.setConfigItem(option, value);
             break;
@@ -359,6 +367,8 @@ Amiga::configure(Option option, i64 value)
         case OPT_BRIGHTNESS:
         case OPT_CONTRAST:
         case OPT_SATURATION:
+        case OPT_FRAME_FORMAT:
+        case OPT_RENDER_THREAD:
             
             denise.pixelEngine.setConfigItem(option, value);
             break;
@@ -944,6 +954,13 @@ Amiga::execute()
     }
 }
 
+void
+Amiga::serviceRequests()
+{
+    // Process the packets received by the remote servers
+    remoteManager.processPackets();
+}
+
 void
 Amiga::setFlag(u32 flag)
 {
@@ -197,6 +197,7 @@ private:
 private:
     
     void execute() override;
+    void serviceRequests() override;
 
     
     //
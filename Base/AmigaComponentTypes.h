@@ -30,6 +30,8 @@ enum_long(OPT)
     OPT_BRIGHTNESS,
     OPT_CONTRAST,
     OPT_SATURATION,
+    OPT_FRAME_FORMAT,
+    OPT_RENDER_THREAD,
     
     // DMA Debugger
     OPT_DMA_DEBUG_ENABLE,
@@ -86,6 +88,11 @@ enum_long(OPT)
     OPT_CLX_SPR_SPR,
     OPT_CLX_SPR_PLF,
     OPT_CLX_PLF_PLF,
+
+    // Rendering
+    OPT_FRAME_SKIP,
+    OPT_FRAME_SKIP_INTERVAL,
+    OPT_WARP_FRAME_SKIP,
         
     // Blitter
     OPT_BLITTER_ACCURACY,
@@ -142,6 +149,9 @@ struct OptionEnum : util::Reflection<OptionEnum, Option>
                 
             case OPT_DENISE_REVISION:       return "DENISE_REVISION";
                 
+            case OPT_FRAME_FORMAT:          return "FRAME_FORMAT";
+            case OPT_RENDER_THREAD:         return "RENDER_THREAD";
+
             case OPT_REG_RESET_VAL:         return "REG_RESET_VAL";
                 
             case OPT_RTC_MODEL:             return "RTC_MODEL";
@@ -184,6 +194,10 @@ struct OptionEnum : util::Reflection<OptionEnum, Option>
             case OPT_CLX_SPR_SPR:           return "CLX_SPR_SPR";
             case OPT_CLX_SPR_PLF:           return "CLX_SPR_PLF";
             case OPT_CLX_PLF_PLF:           return "CLX_PLF_PLF";
+
+            case OPT_FRAME_SKIP:            return "FRAME_SKIP";
+            case OPT_FRAME_SKIP_INTERVAL:   return "FRAME_SKIP_INTERVAL";
+            case OPT_WARP_FRAME_SKIP:       return "WARP_FRAME_SKIP";
                     
             case OPT_BLITTER_ACCURACY:      return "BLITTER_ACCURACY";
                 
@@ -103,10 +103,12 @@ Thread::main()
            
         if (isRunning()) {
                         
+            executing = true;
             switch (mode) {
                 case SyncMode::Periodic: execute<SyncMode::Periodic>(); break;
                 case SyncMode::Pulsed: execute<SyncMode::Pulsed>(); break;
             }
+            executing = false;
         }
         
         if (!warpMode || isPaused()) {
@@ -116,87 +118,107 @@ Thread::main()
                 case SyncMode::Pulsed: sleep<SyncMode::Pulsed>(); break;
             }
         }
+
+        // Process pending requests from other threads
+        serviceRequests();
         
         // Are we requested to enter or exit warp mode?
-        while (newWarpMode != warpMode) {
+        applyWarpChange();
+
+        // Are we requested to enter or exit debug mode?
+        applyDebugChange();
+
+        // Are we requested to change state?
+        applyStateChange();
+        if (state == EXEC_HALTED) return;
+        
+        // Compute the CPU load once in a while
+        if (loopCounter % 32 == 0) {
             
-            AmigaComponent::warpOnOff(newWarpMode);
-            warpMode = newWarpMode;
-            break;
+            auto used  = loadClock.getElapsedTime().asSeconds();
+            auto total = nonstopClock.getElapsedTime().asSeconds();
+            
+            cpuLoad = used / total;
+            
+            loadClock.restart();
+            loadClock.stop();
+            nonstopClock.restart();
         }
+    }
+}
 
-        // Are we requested to enter or exit warp mode?
-        while (newDebugMode != debugMode) {
+void
+Thread::applyWarpChange()
+{
+    if (newWarpMode != warpMode) {
+        
+        AmigaComponent::warpOnOff(newWarpMode);
+        warpMode = newWarpMode;
+    }
+}
+
+void
+Thread::applyDebugChange()
+{
+    if (newDebugMode != debugMode) {
+        
+        AmigaComponent::debugOnOff(newDebugMode);
+        debugMode = newDebugMode;
+    }
+}
+
+void
+Thread::applyStateChange()
+{
+    while (newState != state) {
+        
+        if (state == EXEC_OFF && newState == EXEC_PAUSED) {
             
-            AmigaComponent::debugOnOff(newDebugMode);
-            debugMode = newDebugMode;
+            AmigaComponent::powerOn();
+            state = EXEC_PAUSED;
             break;
         }
 
-        // Are we requested to change state?
-        while (newState != state) {
+        if (state == EXEC_PAUSED && newState == EXEC_OFF) {
             
-            if (state == EXEC_OFF && newState == EXEC_PAUSED) {
-                
-                AmigaComponent::powerOn();
-                state = EXEC_PAUSED;
-                break;
-            }
-
-            if (state == EXEC_PAUSED && newState == EXEC_OFF) {
-                
-                AmigaComponent::powerOff();
-                state = EXEC_OFF;
-                break;
-            }
-
-            if (state == EXEC_PAUSED && newState == EXEC_RUNNING) {
-                
-                AmigaComponent::run();
-                state = EXEC_RUNNING;
-                break;
-            }
+            AmigaComponent::powerOff();
+            state = EXEC_OFF;
+            break;
+        }
 
-            if (state == EXEC_RUNNING && newState == EXEC_OFF) {
-                
-                AmigaComponent::pause();
-                state = EXEC_PAUSED;
-                AmigaComponent::powerOff();
-                state = EXEC_OFF;
-                break;
-            }
+        if (state == EXEC_PAUSED && newState == EXEC_RUNNING) {
+            
+            AmigaComponent::run();
+            state = EXEC_RUNNING;
+            break;
+        }
 
-            if (state == EXEC_RUNNING && newState == EXEC_PAUSED) {
-                
-                AmigaComponent::pause();
-                state = EXEC_PAUSED;
-                break;
-            }
+        if (state == EXEC_RUNNING && newState == EXEC_OFF) {
             
-            if (newState == EXEC_HALTED) {
-                
-                AmigaComponent::halt();
-                state = EXEC_HALTED;
-                return;
-            }
+            AmigaComponent::pause();
+            state = EXEC_PAUSED;
+            AmigaComponent::powerOff();
+            state = EXEC_OFF;
+            break;
+        }
+
+        if (state == EXEC_RUNNING && newState == EXEC_PAUSED) {
             
-            // Invalid state transition
-            fatalError;
+            AmigaComponent::pause();
+            state = EXEC_PAUSED;
             break;
         }
         
-        // Compute the CPU load once in a while
-        if (loopCounter % 32 == 0) {
-            
-            auto used  = loadClock.getElapsedTime().asSeconds();
-            auto total = nonstopClock.getElapsedTime().asSeconds();
+        if (newState == EXEC_HALTED) {
             
-            cpuLoad = used / total;
-            
-            loadClock.restart();
-            loadClock.stop();
-            nonstopClock.restart();
+            AmigaComponent::halt();
+            state = EXEC_HALTED;
+            return;
         }
+        
+        // Invalid state transition
+        fatalError;
+        break;
     }
 }
 
@@ -229,9 +251,6 @@ Thread::powerOn(bool blocking)
 {
     debug(RUN_DEBUG, "powerOn()\n");
 
-    // Never call this function inside the emulator thread
-    assert(!isEmulatorThread());
-    
     if (isPoweredOff()) {
         
         // Request a state change and wait until the new state has been reached
@@ -244,9 +263,6 @@ Thread::powerOff(bool blocking)
 {
     debug(RUN_DEBUG, "powerOff()\n");
 
-    // Never call this function inside the emulator thread
-    assert(!isEmulatorThread());
-    
     if (!isPoweredOff()) {
                 
         // Request a state change and wait until the new state has been reached
@@ -259,9 +275,6 @@ Thread::run(bool blocking)
 {
     debug(RUN_DEBUG, "run()\n");
 
-    // Never call this function inside the emulator thread
-    assert(!isEmulatorThread());
-
     // The emulator is expected to be powered on
     if (isPoweredOff()) throw VAError(ERROR_POWERED_OFF);
         
@@ -280,9 +293,6 @@ Thread::pause(bool blocking)
 {
     debug(RUN_DEBUG, "pause()\n");
 
-    // Never call this function inside the emulator thread
-    assert(!isEmulatorThread());
-    
     if (isRunning()) {
                 
         // Request a state change and wait until the new state has been reached
@@ -330,6 +340,17 @@ void
 Thread::changeStateTo(ExecutionState requestedState, bool blocking)
 {
     newState = requestedState;
+
+    /* Inside the emulator thread, the request is served immediately. If it is
+     * issued while the emulator is executing, it is served when the current
+     * iteration of the main loop has finished.
+     */
+    if (isEmulatorThread()) {
+
+        if (!executing) applyStateChange();
+        return;
+    }
+
     if (blocking) while (state != newState) { };
 }
 
@@ -337,6 +358,14 @@ void
 Thread::changeWarpTo(u8 value, bool blocking)
 {
     newWarpMode = value;
+
+    // Inside the emulator thread, the request is served like a state change
+    if (isEmulatorThread()) {
+
+        if (!executing) applyWarpChange();
+        return;
+    }
+
     if (blocking) while (warpMode != newWarpMode) { };
 }
 
@@ -344,6 +373,14 @@ void
 Thread::changeDebugTo(u8 value, bool blocking)
 {
     newDebugMode = value;
+
+    // Inside the emulator thread, the request is served like a state change
+    if (isEmulatorThread()) {
+
+        if (!executing) applyDebugChange();
+        return;
+    }
+
     if (blocking) while (debugMode != newDebugMode) { };
 }
 
@@ -357,7 +394,10 @@ void
 SuspendableThread::suspend()
 {
     debug(RUN_DEBUG, "Suspending (%ld)...\n", suspendCounter);
-    
+
+    // Inside the emulator thread, there is nothing to suspend
+    if (isEmulatorThread()) return;
+
     if (suspendCounter || isRunning()) {
         pause();
         suspendCounter++;
@@ -368,7 +408,9 @@ void
 SuspendableThread::resume()
 {
     debug(RUN_DEBUG, "Resuming (%ld)...\n", suspendCounter);
-    
+
+    if (isEmulatorThread()) return;
+
     if (suspendCounter && --suspendCounter == 0) {
         run();
     }
@@ -69,6 +69,16 @@
  * mode puts the thread to sleep indefinitely and waits for an external signal
  * (a call to wakeUp()) to continue.
  *
+ * After each iteration, the thread also calls serviceRequests(). The function
+ * is called in all states, i.e., also while the emulator is paused or powered
+ * off. It provides a safe point for processing requests that have been issued
+ * by other threads, such as commands received by the remote servers. When
+ * called inside the emulator thread, suspend() and resume() have no effect.
+ * State changes and changes of the warp or debug mode requested inside the
+ * emulator thread are carried out immediately or, if requested during
+ * execute(), when the current iteration has finished. The calling thread
+ * never waits for such a request to complete.
+ *
  * To speed up emulation (e.g., during disk accesses), the emulator may be put
  * into warp mode. In this mode, timing synchronization is disabled causing the
  * emulator to run as fast as possible. The current warp mode setting can be
@@ -113,6 +123,9 @@ class Thread : public AmigaComponent, util::Wakeable {
     // Counters
     isize loopCounter = 0;
 
+    // Indicates if the thread is inside the execution function
+    bool executing = false;
+
     // Synchronization variables
     util::Time delay = util::Time(1000000000 / 50);
     util::Time targetTime;
@@ -152,6 +165,11 @@ private:
     // The code to be executed in each iteration (implemented by the subclass)
     virtual void execute() = 0;
 
+    // Processes requests from other threads (implemented by the subclass)
+    virtual void serviceRequests() { }
+
+protected:
+
     // Returns true if this functions is called from within the emulator thread
     bool isEmulatorThread() { return std::this_thread::get_id() == thread.get_id(); }
 
@@ -203,8 +221,11 @@ public:
 private:
 
     void changeStateTo(ExecutionState requestedState, bool blocking);
+    void applyStateChange();
     void changeWarpTo(u8 value, bool blocking = true);
+    void applyWarpChange();
     void changeDebugTo(u8 value, bool blocking = true);
+    void applyDebugChange();
     
     
     //
@@ -178,6 +178,12 @@ Moira::addressErrorHandler()
     
 }
 
+void
+Moira::recordInstruction()
+{
+    cpu.tracer.record(reg, getSR(), queue.ird, clock);
+}
+
 void
 Moira::breakpointReached(u32 addr)
 {
@@ -265,6 +271,9 @@ CPU::_reset(bool hard)
         
         // Remove all previously recorded instructions
         debugger.clearLog();
+
+        // Keep on recording if a trace file is open
+        if (tracer.isRecording()) flags |= CPU_RECORD_TRACE;
         
     } else {
         
@@ -387,6 +396,13 @@ CPU::didLoadFromBuffer(const u8 *buffer)
      */
     debugger.breakpoints.setNeedsCheck(debugger.breakpoints.elements() != 0);
     debugger.watchpoints.setNeedsCheck(debugger.watchpoints.elements() != 0);
+
+    // The same holds for the trace recording flag
+    if (tracer.isRecording()) {
+        flags |= CPU_RECORD_TRACE;
+    } else {
+        flags &= ~CPU_RECORD_TRACE;
+    }
     return 0;
 }
 
@@ -460,6 +476,24 @@ CPU::disassembleWords(isize len)
     return disassembleWords(reg.pc0, len);
 }
 
+void
+CPU::startTracing(const string &path)
+{
+    SUSPENDED
+
+    tracer.start(path);
+    flags |= CPU_RECORD_TRACE;
+}
+
+void
+CPU::stopTracing()
+{
+    SUSPENDED
+
+    flags &= ~CPU_RECORD_TRACE;
+    tracer.stop();
+}
+
 void
 CPU::jump(u32 addr)
 {
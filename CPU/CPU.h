@@ -12,6 +12,7 @@
 #include "CPUTypes.h"
 #include "SubComponent.h"
 #include "Moira.h"
+#include "TraceRecorder.h"
 
 class CPU : public moira::Moira {
 
@@ -21,6 +22,11 @@ class CPU : public moira::Moira {
     // Result of the latest inspection
     mutable CPUInfo info = {};
 
+public:
+
+    // Instruction trace recorder
+    TraceRecorder tracer;
+
     
     //
     // Initializing
@@ -161,6 +167,22 @@ public:
     const char *disassembleWords(isize len);
     
     
+    //
+    // Recording traces
+    //
+
+public:
+
+    // Starts streaming all executed instructions into a trace file
+    void startTracing(const string &path) throws;
+
+    // Stops recording and finalizes the trace file
+    void stopTracing() throws;
+
+    // Indicates whether a trace file is being recorded
+    bool isTracing() const { return tracer.isRecording(); }
+
+
     //
     // Changing state
     //
@@ -147,6 +147,11 @@ Moira::execute()
         debugger.logInstruction();
     }
 
+    // If tracing is enabled, pass the instruction to the trace recorder
+    if (flags & CPU_RECORD_TRACE) {
+        recordInstruction();
+    }
+
     // Execute the instruction
     reg.pc += 2;
     (this->*exec[queue.ird])(queue.ird);
@@ -92,6 +92,10 @@ protected:
      *
      * CPU_CHECK_WP:
      *    This flag indicates whether the CPU should check fo watchpoints.
+     *
+     * CPU_RECORD_TRACE:
+     *    This flag is set if trace recording is enabled. If set, the CPU
+     *    passes each instruction to the recordInstruction() delegate.
      */
     int flags;
     static const int CPU_IS_HALTED         = (1 << 8);
@@ -102,6 +106,7 @@ protected:
     static const int CPU_TRACE_FLAG        = (1 << 13);
     static const int CPU_CHECK_BP          = (1 << 14);
     static const int CPU_CHECK_WP          = (1 << 15);
+    static const int CPU_RECORD_TRACE      = (1 << 16);
 
     // Number of elapsed cycles since powerup
     i64 clock;
@@ -292,6 +297,9 @@ protected:
     // Exception delegates
     void addressErrorHandler();
     
+    // Called before an instruction is executed if trace recording is enabled
+    void recordInstruction();
+
     // Called when a breakpoint is reached
     void breakpointReached(u32 addr);
 
@@ -101,6 +101,7 @@ Guards::addAt(u32 addr, long skip)
     guards[count].hits = 0;
     guards[count].skip = skip;
     count++;
+    updatePageMap();
     setNeedsCheck(true);
 }
 
@@ -122,6 +123,7 @@ Guards::removeAt(u32 addr)
             break;
         }
     }
+    updatePageMap();
     setNeedsCheck(count != 0);
 }
 
@@ -132,6 +134,7 @@ Guards::replace(long nr, u32 addr)
     
     guards[nr].addr = addr;
     guards[nr].hits = 0;
+    updatePageMap();
 }
 
 bool
@@ -153,9 +156,24 @@ Guards::setEnableAt(u32 addr, bool value)
     if (guard) guard->enabled = value;
 }
 
+void
+Guards::updatePageMap()
+{
+    memset(pageMap, 0, sizeof(pageMap));
+
+    for (int i = 0; i < count; i++) {
+
+        u32 page = (guards[i].addr >> 8) & (pageMapSize - 1);
+        pageMap[page >> 6] |= u64(1) << (page & 63);
+    }
+}
+
 bool
 Guards::eval(u32 addr, Size S)
 {
+    // Most addresses are ruled out by the page map
+    if (!mayMatch(addr, S)) return false;
+
     for (int i = 0; i < count; i++)
         if (guards[i].eval(addr, S)) return true;
 
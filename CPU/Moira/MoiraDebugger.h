@@ -56,6 +56,14 @@ protected:
     // Number of currently stored guards
     long count = 0;
 
+    /* Page map with one bit for each 256 byte page. A bit is set if a guard
+     * is located in the corresponding page. The map is used to filter out
+     * most addresses before the guard list is scanned. Addresses beyond the
+     * 24 bit address space are folded into the map.
+     */
+    static const int pageMapSize = 1 << 16;
+    u64 pageMap[pageMapSize / 64] = { };
+
     // Indicates if guard checking is necessary
     virtual void setNeedsCheck(bool value) = 0;
 
@@ -91,7 +99,7 @@ public:
     void removeAt(u32 addr);
 
     void remove(long nr);
-    void removeAll() { count = 0; setNeedsCheck(false); }
+    void removeAll() { count = 0; updatePageMap(); setNeedsCheck(false); }
 
     void replace(long nr, u32 addr);
 
@@ -117,6 +125,19 @@ public:
 private:
 
     bool eval(u32 addr, Size S = Byte);
+
+    // Checks if a guard may be located in the specified address range
+    bool mayMatch(u32 addr, Size S = Byte) const {
+
+        u32 first = (addr >> 8) & (pageMapSize - 1);
+        u32 last = ((addr + S - 1) >> 8) & (pageMapSize - 1);
+
+        return ((pageMap[first >> 6] >> (first & 63)) & 1) ||
+        ((pageMap[last >> 6] >> (last & 63)) & 1);
+    }
+
+    // Rebuilds the page map from the guard list
+    void updatePageMap();
 };
 
 class Breakpoints : public Guards {
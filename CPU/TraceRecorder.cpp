@@ -0,0 +1,450 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "TraceRecorder.h"
+#include "Error.h"
+#include "Macros.h"
+#include <cstring>
+
+//
+// Encoding helpers
+//
+
+static const u8 traceMagic[7] = { 'V', 'A', 'T', 'R', 'A', 'C', 'E' };
+static const u8 indexMagic[7] = { 'V', 'A', 'I', 'N', 'D', 'E', 'X' };
+
+static inline u32 zigzag(u32 delta) { return (delta << 1) ^ (u32)((i32)delta >> 31); }
+static inline u32 unzigzag(u32 value) { return (value >> 1) ^ (0 - (value & 1)); }
+
+static inline u8 *
+putVarint(u8 *p, u64 value)
+{
+    while (value >= 0x80) { *p++ = (u8)(value | 0x80); value >>= 7; }
+    *p++ = (u8)value;
+    return p;
+}
+
+static inline const u8 *
+getVarint(const u8 *p, const u8 *end, u64 &value)
+{
+    value = 0;
+    for (isize shift = 0; p < end && shift < 64; shift += 7) {
+
+        value |= u64(*p & 0x7F) << shift;
+        if (!(*p++ & 0x80)) return p;
+    }
+    return nullptr;
+}
+
+static inline void
+put64(u8 *p, u64 value)
+{
+    W32BE(p, (u32)(value >> 32)); W32BE(p + 4, (u32)value);
+}
+
+static inline u64
+get64(const u8 *p)
+{
+    return u64(R32BE(p)) << 32 | R32BE(p + 4);
+}
+
+
+//
+// TraceRecorder
+//
+
+TraceRecorder::~TraceRecorder()
+{
+    try { stop(); } catch (...) { }
+}
+
+void
+TraceRecorder::start(const string &path)
+{
+    if (isRecording()) stop();
+
+    stream.open(path, std::ofstream::binary | std::ofstream::trunc);
+    if (!stream.is_open()) throw VAError(ERROR_FILE_CANT_CREATE, path);
+
+    u8 header[headerSize];
+    std::memcpy(header, traceMagic, sizeof(traceMagic));
+    header[7] = version;
+    stream.write((const char *)header, headerSize);
+
+    this->path = path;
+    buffer.resize(chunkSize + maxEntrySize);
+    size = count = 0;
+    recorded = 0;
+    index.clear();
+    failed = !stream.good();
+    quit = false;
+    clearState();
+
+    writer = std::thread(&TraceRecorder::writeLoop, this);
+}
+
+void
+TraceRecorder::stop()
+{
+    if (!isRecording()) return;
+
+    // Hand over the last chunk and let the writer drain the queue
+    if (count) seal();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    cond.notify_all();
+    writer.join();
+
+    // Append the index and the footer
+    auto indexOffset = (i64)stream.tellp();
+    for (auto &entry : index) {
+
+        u8 data[indexEntrySize];
+        put64(data, entry.offset);
+        put64(data + 8, entry.firstCycle);
+        put64(data + 16, entry.firstEntry);
+        stream.write((const char *)data, indexEntrySize);
+    }
+
+    u8 footer[footerSize];
+    put64(footer, indexOffset);
+    put64(footer + 8, index.size());
+    put64(footer + 16, recorded);
+    std::memcpy(footer + 24, indexMagic, sizeof(indexMagic));
+    footer[31] = version;
+    stream.write((const char *)footer, footerSize);
+
+    stream.close();
+    pool.clear();
+
+    if (failed || stream.fail()) throw VAError(ERROR_FILE_CANT_WRITE, path);
+}
+
+void
+TraceRecorder::record(const moira::Registers &reg, u16 sr, u16 opcode, i64 cycle)
+{
+    // Start a new chunk if the current one is full or the clock went back
+    if (size >= chunkSize || cycle < this->cycle) seal();
+
+    if (count == 0) firstCycle = this->cycle = cycle;
+
+    u8 *p = buffer.data() + size;
+    u8 *tag = p++;
+    u8 flags = 0;
+
+    p = putVarint(p, u64(cycle - this->cycle));
+    p = putVarint(p, zigzag(reg.pc - pc));
+    W16BE(p, opcode); p += 2;
+
+    if (sr != this->sr) {
+
+        flags |= TAG_SR;
+        W16BE(p, sr); p += 2;
+    }
+
+    u16 mask = 0;
+    for (isize i = 0; i < 16; i++) if (reg.r[i] != r[i]) mask |= 1 << i;
+
+    if (mask) {
+
+        flags |= TAG_REGS;
+        W16BE(p, mask); p += 2;
+        for (isize i = 0; i < 16; i++) {
+
+            if (mask & (1 << i)) {
+
+                p = putVarint(p, zigzag(reg.r[i] - r[i]));
+                r[i] = reg.r[i];
+            }
+        }
+    }
+    if (reg.usp != usp) {
+
+        flags |= TAG_USP;
+        p = putVarint(p, zigzag(reg.usp - usp));
+    }
+    if (reg.ssp != ssp) {
+
+        flags |= TAG_SSP;
+        p = putVarint(p, zigzag(reg.ssp - ssp));
+    }
+    *tag = flags;
+
+    assert(p - (buffer.data() + size) <= maxEntrySize);
+
+    this->cycle = cycle;
+    this->pc = reg.pc;
+    this->sr = sr;
+    this->usp = reg.usp;
+    this->ssp = reg.ssp;
+
+    size = p - buffer.data();
+    count++;
+    recorded++;
+}
+
+void
+TraceRecorder::seal()
+{
+    if (count) {
+
+        std::unique_lock<std::mutex> lock(mutex);
+
+        // Wait until the writer has caught up
+        cond.wait(lock, [this]{ return (isize)queue.size() < maxQueued; });
+
+        queue.push_back(Chunk {
+            std::move(buffer), size, count, firstCycle, recorded - count });
+
+        // Continue with a recycled buffer
+        if (pool.empty()) {
+            buffer = std::vector<u8>(chunkSize + maxEntrySize);
+        } else {
+            buffer = std::move(pool.back());
+            pool.pop_back();
+        }
+    }
+    cond.notify_all();
+
+    size = count = 0;
+    clearState();
+}
+
+void
+TraceRecorder::writeLoop()
+{
+    while (true) {
+
+        Chunk chunk;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this]{ return !queue.empty() || quit; });
+            if (queue.empty()) break;
+
+            chunk = std::move(queue.front());
+            queue.pop_front();
+        }
+        cond.notify_all();
+
+        if (!failed) {
+
+            index.push_back(IndexEntry {
+                (i64)stream.tellp(), chunk.firstCycle, chunk.firstEntry });
+
+            u8 header[chunkHeaderSize];
+            W32BE(header, (u32)chunk.size);
+            W32BE(header + 4, (u32)chunk.count);
+            put64(header + 8, chunk.firstCycle);
+            stream.write((const char *)header, chunkHeaderSize);
+            stream.write((const char *)chunk.data.data(), chunk.size);
+
+            failed = !stream.good();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        pool.push_back(std::move(chunk.data));
+    }
+}
+
+void
+TraceRecorder::clearState()
+{
+    pc = 0;
+    sr = 0;
+    usp = 0;
+    ssp = 0;
+    std::memset(r, 0, sizeof(r));
+}
+
+
+//
+// TraceReader
+//
+
+TraceReader::TraceReader(const string &path) : path(path)
+{
+    stream.open(path, std::ifstream::binary);
+    if (!stream.is_open()) throw VAError(ERROR_FILE_NOT_FOUND, path);
+
+    // Check the header
+    u8 header[TraceRecorder::headerSize];
+    if (!stream.read((char *)header, TraceRecorder::headerSize) ||
+        std::memcmp(header, traceMagic, sizeof(traceMagic)) != 0 ||
+        header[7] != TraceRecorder::version) {
+        throw VAError(ERROR_FILE_TYPE_MISMATCH, path);
+    }
+
+    // Read the footer
+    u8 footer[TraceRecorder::footerSize];
+    stream.seekg(-TraceRecorder::footerSize, std::ios::end);
+    auto footerOffset = (i64)stream.tellg();
+    if (!stream.read((char *)footer, TraceRecorder::footerSize) ||
+        std::memcmp(footer + 24, indexMagic, sizeof(indexMagic)) != 0) {
+        throw VAError(ERROR_FILE_TYPE_MISMATCH, path);
+    }
+    auto indexOffset = (i64)get64(footer);
+    auto numChunks = (i64)get64(footer + 8);
+    entries = (i64)get64(footer + 16);
+
+    if (indexOffset + numChunks * TraceRecorder::indexEntrySize != footerOffset) {
+        throw VAError(ERROR_FILE_TYPE_MISMATCH, path);
+    }
+
+    // Read the index
+    std::vector<u8> data(numChunks * TraceRecorder::indexEntrySize);
+    stream.seekg(indexOffset);
+    if (!stream.read((char *)data.data(), data.size())) {
+        throw VAError(ERROR_FILE_CANT_READ, path);
+    }
+    for (isize i = 0; i < numChunks; i++) {
+
+        auto p = data.data() + i * TraceRecorder::indexEntrySize;
+        index.push_back(TraceRecorder::IndexEntry {
+            (i64)get64(p), (i64)get64(p + 8), (i64)get64(p + 16) });
+    }
+}
+
+void
+TraceReader::rewind()
+{
+    chunkNr = -1;
+    chunkCount = 0;
+    decoded = 0;
+    lookahead = false;
+}
+
+void
+TraceReader::seek(i64 cycle)
+{
+    rewind();
+
+    /* The first cycles in the index only grow within a single clock epoch.
+     * The recorder starts a new chunk whenever the clock goes back (e.g.,
+     * after a reset). Hence, the index is scanned linearly. A chunk is skipped
+     * without decoding it if the next chunk belongs to the same epoch and
+     * starts before the specified cycle.
+     */
+    for (isize nr = 0; nr < (isize)index.size(); nr++) {
+
+        if (nr + 1 < (isize)index.size()) {
+
+            auto first = index[nr].firstCycle;
+            auto next = index[nr + 1].firstCycle;
+            if (next >= first && next < cycle) continue;
+        }
+
+        load(nr);
+
+        // Skip all entries preceding the specified cycle
+        while (decoded < chunkCount && decode()) {
+
+            if (state.cycle >= cycle) { lookahead = true; return; }
+        }
+    }
+}
+
+bool
+TraceReader::next(TraceEntry &entry)
+{
+    if (!lookahead && !decode()) return false;
+
+    entry = state;
+    lookahead = false;
+    return true;
+}
+
+void
+TraceReader::load(isize nr)
+{
+    assert(nr >= 0 && nr < (isize)index.size());
+
+    u8 header[TraceRecorder::chunkHeaderSize];
+    stream.clear();
+    stream.seekg(index[nr].offset);
+    if (!stream.read((char *)header, TraceRecorder::chunkHeaderSize)) {
+        throw VAError(ERROR_FILE_CANT_READ, path);
+    }
+
+    chunk.resize(R32BE(header));
+    if (!stream.read((char *)chunk.data(), chunk.size())) {
+        throw VAError(ERROR_FILE_CANT_READ, path);
+    }
+
+    chunkNr = nr;
+    chunkCount = R32BE(header + 4);
+    offset = 0;
+    decoded = 0;
+
+    // The delta encoding restarts with each chunk
+    state = { };
+    state.cycle = (i64)get64(header + 8);
+}
+
+bool
+TraceReader::decode()
+{
+    // Move on to the next chunk if the current one is exhausted
+    while (decoded == chunkCount) {
+
+        if (chunkNr + 1 >= (isize)index.size()) return false;
+        load(chunkNr + 1);
+    }
+
+    const u8 *p = chunk.data() + offset;
+    const u8 *end = chunk.data() + chunk.size();
+    u64 value;
+
+    auto varint = [&]() {
+        if (!p || !(p = getVarint(p, end, value))) {
+            throw VAError(ERROR_FILE_CANT_READ, path);
+        }
+        return value;
+    };
+    auto word = [&]() {
+        if (end - p < 2) throw VAError(ERROR_FILE_CANT_READ, path);
+        u16 result = R16BE(p); p += 2;
+        return result;
+    };
+
+    if (p >= end) throw VAError(ERROR_FILE_CANT_READ, path);
+    u8 tag = *p++;
+
+    state.cycle += (i64)varint();
+    state.pc += unzigzag((u32)varint());
+    state.opcode = word();
+
+    if (tag & TraceRecorder::TAG_SR) {
+        state.sr = word();
+    }
+    if (tag & TraceRecorder::TAG_REGS) {
+
+        u16 mask = word();
+        for (isize i = 0; i < 16; i++) {
+
+            if (mask & (1 << i)) {
+
+                u32 &reg = i < 8 ? state.d[i] : state.a[i - 8];
+                reg += unzigzag((u32)varint());
+            }
+        }
+    }
+    if (tag & TraceRecorder::TAG_USP) {
+        state.usp += unzigzag((u32)varint());
+    }
+    if (tag & TraceRecorder::TAG_SSP) {
+        state.ssp += unzigzag((u32)varint());
+    }
+
+    offset = p - chunk.data();
+    decoded++;
+    return true;
+}
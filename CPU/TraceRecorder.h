@@ -0,0 +1,264 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "Types.h"
+#include "Exception.h"
+#include "MoiraTypes.h"
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Instruction traces
+ *
+ * The trace recorder writes every executed instruction into a file. Unlike
+ * the log buffer of the Moira debugger, which keeps a full copy of the
+ * register set for the most recent instructions, the recorder only stores the
+ * differences between two consecutive entries. Each entry is encoded as
+ * follows:
+ *
+ *     u8     Tag (indicates which of the optional fields are present)
+ *     varint Elapsed CPU cycles since the previous entry
+ *     varint Distance to the previous program counter (zigzag encoded)
+ *     u16    Opcode
+ *     u16    Status register              (if TAG_SR is set)
+ *     u16    Mask of changed registers    (if TAG_REGS is set)
+ *     varint Change of each register      (zigzag encoded, one per mask bit)
+ *     varint Change of USP and SSP        (if TAG_USP or TAG_SSP is set)
+ *
+ * Entries are grouped into chunks. The delta encoding restarts at the
+ * beginning of each chunk, i.e., the first entry of a chunk is encoded against
+ * an all-zero register set and serves as a keyframe. Hence, each chunk can be
+ * decoded on its own. Completed chunks are handed over to a background thread
+ * which streams them to disk. When recording stops, an index with the
+ * location and the first cycle of each chunk is appended to the file. The
+ * index enables the reader to seek to a certain cycle without decoding the
+ * preceding chunks.
+ *
+ * File layout (all values in big endian format):
+ *
+ *     Header: "VATRACE" + version byte
+ *     Chunk:  u32 payload size, u32 entry count, u64 first cycle, payload
+ *     ...
+ *     Index:  u64 file offset, u64 first cycle, u64 first entry (per chunk)
+ *     Footer: u64 index offset, u64 chunk count, u64 entry count,
+ *             "VAINDEX" + version byte
+ */
+
+// A single decoded trace entry
+struct TraceEntry {
+
+    // CPU cycle at the beginning of the instruction
+    i64 cycle;
+
+    // Address and opcode of the instruction
+    u32 pc;
+    u16 opcode;
+
+    // Register contents before the instruction was executed
+    u16 sr;
+    u32 d[8];
+    u32 a[8];
+    u32 usp;
+    u32 ssp;
+};
+
+class TraceRecorder {
+
+    friend class TraceReader;
+
+    // Format version
+    static constexpr u8 version = 1;
+
+    // Sizes of the fixed file sections
+    static constexpr isize headerSize = 8;
+    static constexpr isize chunkHeaderSize = 16;
+    static constexpr isize indexEntrySize = 24;
+    static constexpr isize footerSize = 32;
+
+    // Chunks are sealed once the payload exceeds this size
+    static constexpr isize chunkSize = 64 * 1024;
+
+    // Maximum number of bytes needed to encode a single entry
+    static constexpr isize maxEntrySize = 128;
+
+    // Maximum number of chunks waiting for the writer thread
+    static constexpr isize maxQueued = 64;
+
+    // Tag bits
+    static constexpr u8 TAG_SR   = 0x01;
+    static constexpr u8 TAG_REGS = 0x02;
+    static constexpr u8 TAG_USP  = 0x04;
+    static constexpr u8 TAG_SSP  = 0x08;
+
+    // A chunk waiting to be written
+    struct Chunk {
+
+        std::vector<u8> data;
+        isize size;
+        isize count;
+        i64 firstCycle;
+        i64 firstEntry;
+    };
+
+    // Location of a chunk inside the trace file
+    struct IndexEntry {
+
+        i64 offset;
+        i64 firstCycle;
+        i64 firstEntry;
+    };
+
+    // The trace file
+    string path;
+    std::ofstream stream;
+
+    // The chunk that is currently filled
+    std::vector<u8> buffer;
+    isize size = 0;
+    isize count = 0;
+    i64 firstCycle = 0;
+
+    // Total number of recorded instructions
+    i64 recorded = 0;
+
+    // The most recently recorded state (used for delta encoding)
+    u32 pc = 0;
+    u16 sr = 0;
+    u32 r[16] = { };
+    u32 usp = 0;
+    u32 ssp = 0;
+    i64 cycle = 0;
+
+    // Chunks to be written and recycled chunk buffers
+    std::deque<Chunk> queue;
+    std::vector<std::vector<u8>> pool;
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool quit = false;
+
+    // The writer thread and the chunk index it creates
+    std::thread writer;
+    std::vector<IndexEntry> index;
+    bool failed = false;
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    ~TraceRecorder();
+
+
+    //
+    // Recording
+    //
+
+public:
+
+    // Indicates whether a trace file is being recorded
+    bool isRecording() const { return writer.joinable(); }
+
+    // Returns the number of recorded instructions
+    i64 recordedInstructions() const { return recorded; }
+
+    // Opens a trace file and launches the writer thread
+    void start(const string &path) throws;
+
+    // Writes all pending chunks and the index and closes the trace file
+    void stop() throws;
+
+    // Adds an instruction to the trace
+    void record(const moira::Registers &reg, u16 sr, u16 opcode, i64 cycle);
+
+private:
+
+    // Hands the current chunk over to the writer thread
+    void seal();
+
+    // Main loop of the writer thread
+    void writeLoop();
+
+    // Restarts the delta encoding
+    void clearState();
+};
+
+class TraceReader {
+
+    // The trace file
+    string path;
+    std::ifstream stream;
+
+    // Total number of entries
+    i64 entries = 0;
+
+    // Chunk index
+    std::vector<TraceRecorder::IndexEntry> index;
+
+    // The currently decoded chunk
+    std::vector<u8> chunk;
+    isize chunkNr = -1;
+    isize chunkCount = 0;
+    isize offset = 0;
+    isize decoded = 0;
+
+    // The most recently decoded entry
+    TraceEntry state = { };
+
+    // Indicates whether the state holds an entry that has not been returned
+    bool lookahead = false;
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    TraceReader(const string &path) throws;
+
+
+    //
+    // Reading
+    //
+
+public:
+
+    // Returns the number of entries in the trace
+    i64 count() const { return entries; }
+
+    // Returns the number of chunks in the trace
+    isize chunks() const { return (isize)index.size(); }
+
+    // Moves to the first entry
+    void rewind() throws;
+
+    /* Moves to the first entry that starts at or after the specified cycle.
+     * If the clock has been reset during recording, the first matching entry
+     * in recording order is selected.
+     */
+    void seek(i64 cycle) throws;
+
+    // Reads the next entry (returns false at the end of the trace)
+    bool next(TraceEntry &entry) throws;
+
+private:
+
+    // Loads a chunk and prepares it for decoding
+    void load(isize nr) throws;
+
+    // Decodes the next entry of the current chunk
+    bool decode() throws;
+};
@@ -14,6 +14,10 @@
 #include "IOUtils.h"
 #include "SSEUtils.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 Denise::Denise(Amiga& ref) : SubComponent(ref)
 {    
     subComponents = std::vector<AmigaComponent *> {
@@ -47,6 +51,9 @@ Denise::getDefaultConfig()
     defaults.clxSprSpr = true;
     defaults.clxSprPlf = true;
     defaults.clxPlfPlf = true;
+    defaults.frameSkip = 0;
+    defaults.frameSkipInterval = 1;
+    defaults.warpFrameSkip = false;
 
     return defaults;
 }
@@ -64,6 +71,9 @@ Denise::resetConfig()
     setConfigItem(OPT_CLX_SPR_SPR, defaults.clxSprSpr);
     setConfigItem(OPT_CLX_SPR_PLF, defaults.clxSprPlf);
     setConfigItem(OPT_CLX_PLF_PLF, defaults.clxPlfPlf);
+    setConfigItem(OPT_FRAME_SKIP, defaults.frameSkip);
+    setConfigItem(OPT_FRAME_SKIP_INTERVAL, defaults.frameSkipInterval);
+    setConfigItem(OPT_WARP_FRAME_SKIP, defaults.warpFrameSkip);
 }
 
 i64
@@ -79,6 +89,9 @@ Denise::getConfigItem(Option option) const
         case OPT_CLX_SPR_SPR:         return config.clxSprSpr;
         case OPT_CLX_SPR_PLF:         return config.clxSprPlf;
         case OPT_CLX_PLF_PLF:         return config.clxPlfPlf;
+        case OPT_FRAME_SKIP:          return config.frameSkip;
+        case OPT_FRAME_SKIP_INTERVAL: return config.frameSkipInterval;
+        case OPT_WARP_FRAME_SKIP:     return config.warpFrameSkip;
             
         default:
             fatalError;
@@ -134,6 +147,29 @@ Denise::setConfigItem(Option option, i64 value)
             config.clxPlfPlf = (bool)value;
             return;
 
+        case OPT_FRAME_SKIP:
+
+            if (value < 0 || value > 255) {
+                throw VAError(ERROR_OPT_INVARG, "0...255");
+            }
+
+            config.frameSkip = (u8)value;
+            return;
+
+        case OPT_FRAME_SKIP_INTERVAL:
+
+            if (value < 1 || value > 255) {
+                throw VAError(ERROR_OPT_INVARG, "1...255");
+            }
+
+            config.frameSkipInterval = (u8)value;
+            return;
+
+        case OPT_WARP_FRAME_SKIP:
+
+            config.warpFrameSkip = (bool)value;
+            return;
+
         default:
             fatalError;
     }
@@ -188,34 +224,10 @@ Denise::extractSlices(u8 slices[16])
     }
 }
 
-void
-Denise::extractSlicesOdd(u8 slices[16])
-{
-    u16 mask = 0x8000;
-    for (isize i = 0; i < 16; i++, mask >>= 1) {
-        
-        slices[i] = (u8) ((!!(shiftReg[0] & mask) << 0) |
-                          (!!(shiftReg[2] & mask) << 2) |
-                          (!!(shiftReg[4] & mask) << 4) );
-    }
-}
-
-void
-Denise::extractSlicesEven(u8 slices[16])
-{
-    u16 mask = 0x8000;
-    for (isize i = 0; i < 16; i++, mask >>= 1) {
-        
-        slices[i] = (u8) ((!!(shiftReg[1] & mask) << 1) |
-                          (!!(shiftReg[3] & mask) << 3) |
-                          (!!(shiftReg[5] & mask) << 5) );
-    }
-}
-
 template <bool hiresMode> void
 Denise::drawOdd(Pixel offset)
 {
-    static constexpr u16 masks[7] = {
+    static constexpr u8 masks[7] = {
         
        0b000000, // 0 bitplanes
        0b000001, // 1 bitplanes
@@ -226,33 +238,12 @@ Denise::drawOdd(Pixel offset)
        0b010101  // 6 bitplanes
     };
     
-    u16 mask = masks[bpu()];
     Pixel currentPixel = agnus.ppos() + offset;
-    
-    u8 slices[16];
-    extractSlicesOdd(slices);
-    
-    for (isize i = 0; i < 16; i++) {
-        
-        u8 index = slices[i] & mask;
-        
-        if (hiresMode) {
-            
-            // Synthesize one hires pixel
-            assert(currentPixel < isizeof(bBuffer));
-            bBuffer[currentPixel] = (bBuffer[currentPixel] & 0b101010) | index;
-            currentPixel++;
-            
-        } else {
-            
-            // Synthesize two lores pixels
-            assert(currentPixel + 1 < isizeof(bBuffer));
-            bBuffer[currentPixel] = (bBuffer[currentPixel] & 0b101010) | index;
-            currentPixel++;
-            bBuffer[currentPixel] = (bBuffer[currentPixel] & 0b101010) | index;
-            currentPixel++;
-        }
-    }
+    assert(currentPixel + (hiresMode ? 16 : 32) <= isizeof(bBuffer));
+
+    // Synthesize 16 hires pixels or 32 lores pixels
+    util::planarToChunky<hiresMode>(shiftReg[0], shiftReg[2], shiftReg[4], 0,
+                                    masks[bpu()], 0b101010, bBuffer + currentPixel);
  
     // Clear the shift registers
     shiftReg[0] = shiftReg[2] = shiftReg[4] = 0;
@@ -261,7 +252,7 @@ Denise::drawOdd(Pixel offset)
 template <bool hiresMode> void
 Denise::drawEven(Pixel offset)
 {    
-    static constexpr u16 masks[7] = {
+    static constexpr u8 masks[7] = {
         
        0b000000, // 0 bitplanes
        0b000000, // 1 bitplanes
@@ -272,33 +263,12 @@ Denise::drawEven(Pixel offset)
        0b101010  // 6 bitplanes
     };
     
-    u16 mask = masks[bpu()];
     Pixel currentPixel = agnus.ppos() + offset;
-    
-    u8 slices[16];
-    extractSlicesEven(slices);
-    
-    for (isize i = 0; i < 16; i++) {
-
-        u8 index = slices[i] & mask;
-        
-        if (hiresMode) {
-            
-            // Synthesize one hires pixel
-            assert(currentPixel < isizeof(bBuffer));
-            bBuffer[currentPixel] = (bBuffer[currentPixel] & 0b010101) | index;
-            currentPixel++;
+    assert(currentPixel + (hiresMode ? 16 : 32) <= isizeof(bBuffer));
 
-        } else {
-            
-            // Synthesize two lores pixels
-            assert(currentPixel + 1 < isizeof(bBuffer));
-            bBuffer[currentPixel] = (bBuffer[currentPixel] & 0b010101) | index;
-            currentPixel++;
-            bBuffer[currentPixel] = (bBuffer[currentPixel] & 0b010101) | index;
-            currentPixel++;
-        }
-    }
+    // Synthesize 16 hires pixels or 32 lores pixels
+    util::planarToChunky<hiresMode>(shiftReg[1], shiftReg[3], shiftReg[5], 1,
+                                    masks[bpu()], 0b010101, bBuffer + currentPixel);
  
     // Clear the shift registers
     shiftReg[1] = shiftReg[3] = shiftReg[5] = 0;
@@ -434,12 +404,7 @@ Denise::translate()
     Pixel pixel = 0;
 
     // Wipe out some bitplane data if requested
-    if (config.hiddenBitplanes) {
-    
-        for (isize i = 0; i < isizeof(bBuffer); i++) {
-            bBuffer[i] &= ~config.hiddenBitplanes;
-        }
-    }
+    hideBitplanes();
     
     // Start with the playfield state as it was at the beginning of the line
     PFState state;
@@ -493,6 +458,17 @@ Denise::translate()
     conChanges.clear();
 }
 
+void
+Denise::hideBitplanes()
+{
+    if (config.hiddenBitplanes) {
+    
+        for (isize i = 0; i < isizeof(bBuffer); i++) {
+            bBuffer[i] &= ~config.hiddenBitplanes;
+        }
+    }
+}
+
 void
 Denise::translateSPF(Pixel from, Pixel to, PFState &state)
 {
@@ -506,6 +482,9 @@ Denise::translateSPF(Pixel from, Pixel to, PFState &state)
      * Denise/BPLCON0/invprio0 to Denise/BPLCON0/invprio3
      */
     
+    // Translate chunks of 16 pixels in parallel
+    if constexpr (!NO_SSE) from = translateSPFSSE(from, to, state);
+
     if (!state.zpf2 && !state.ham) {
         
         for (Pixel i = from; i < to; i++) {
@@ -549,6 +528,9 @@ Denise::translateDPF(Pixel from, Pixel to, PFState &state)
     u8 mask1 = state.zpf1 ? 0b1111 : 0b0000;
     u8 mask2 = state.zpf2 ? 0b1111 : 0b0000;
 
+    // Translate chunks of 16 pixels in parallel
+    if constexpr (!NO_SSE) from = translateDPFSSE <prio> (from, to, state);
+
     for (Pixel i = from; i < to; i++) {
 
         u8 s = bBuffer[i];
@@ -595,6 +577,123 @@ Denise::translateDPF(Pixel from, Pixel to, PFState &state)
     }
 }
 
+#if defined(__SSE2__)
+
+Pixel
+Denise::translateSPFSSE(Pixel from, Pixel to, PFState &state)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bit4 = _mm_set1_epi8(0x10);
+    const __m128i bits45 = _mm_set1_epi8(0x30);
+    const __m128i zpf2 = _mm_set1_epi16((short)state.zpf2);
+    const bool invalid = !state.zpf2 && !state.ham;
+
+    for (; from + 16 <= to; from += 16) {
+
+        __m128i s = _mm_loadu_si128((__m128i *)(bBuffer + from));
+
+        // Eliminate the first four bitplanes where the fifth one is set
+        if (invalid) {
+            __m128i clear = _mm_cmpeq_epi8(_mm_and_si128(s, bit4), zero);
+            s = _mm_and_si128(s, _mm_or_si128(clear, bits45));
+        }
+
+        _mm_storeu_si128((__m128i *)(iBuffer + from), s);
+        _mm_storeu_si128((__m128i *)(mBuffer + from), s);
+
+        // Assign the playfield depth to all solid pixels (zpf2 is 0 if invalid)
+        __m128i transp = _mm_cmpeq_epi8(s, zero);
+        __m128i lo = _mm_andnot_si128(_mm_unpacklo_epi8(transp, transp), zpf2);
+        __m128i hi = _mm_andnot_si128(_mm_unpackhi_epi8(transp, transp), zpf2);
+        _mm_storeu_si128((__m128i *)(zBuffer + from), lo);
+        _mm_storeu_si128((__m128i *)(zBuffer + from + 8), hi);
+    }
+
+    return from;
+}
+
+template <bool prio> Pixel
+Denise::translateDPFSSE(Pixel from, Pixel to, PFState &state)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bit0 = _mm_set1_epi8(0b0001);
+    const __m128i bit1 = _mm_set1_epi8(0b0010);
+    const __m128i bit2 = _mm_set1_epi8(0b0100);
+    const __m128i bit3 = _mm_set1_epi8(0b1000);
+    const __m128i mask1 = _mm_set1_epi8(state.zpf1 ? 0b1111 : 0b0000);
+    const __m128i mask2 = _mm_set1_epi8(state.zpf2 ? 0b1111 : 0b0000);
+
+    // Depth values for all four combinations of solid and transparent pixels
+    const __m128i z0 = _mm_set1_epi16((short)Z_DPF);
+    const __m128i z1 = _mm_set1_epi16((short)(state.zpf1 | Z_DPF1));
+    const __m128i z2 = _mm_set1_epi16((short)(state.zpf2 | Z_DPF2));
+    const __m128i z12 = _mm_set1_epi16((short)(prio ?
+                                                state.zpf2 | Z_DPF21 :
+                                                state.zpf1 | Z_DPF12));
+
+    // Selects the depth values for eight pixels
+    auto depth = [&](__m128i t1, __m128i t2) {
+
+        __m128i none = _mm_and_si128(_mm_and_si128(t1, t2), z0);
+        __m128i only1 = _mm_and_si128(_mm_andnot_si128(t1, t2), z1);
+        __m128i only2 = _mm_and_si128(_mm_andnot_si128(t2, t1), z2);
+        __m128i both = _mm_andnot_si128(_mm_or_si128(t1, t2), z12);
+        return _mm_or_si128(_mm_or_si128(none, only1), _mm_or_si128(only2, both));
+    };
+
+    for (; from + 16 <= to; from += 16) {
+
+        __m128i s = _mm_loadu_si128((__m128i *)(bBuffer + from));
+        __m128i s1 = _mm_srli_epi16(s, 1);
+        __m128i s2 = _mm_srli_epi16(s, 2);
+        __m128i s3 = _mm_srli_epi16(s, 3);
+
+        // Determine color indices for both playfields
+        __m128i index1 = _mm_or_si128(_mm_or_si128(_mm_and_si128(s, bit0),
+                                                   _mm_and_si128(s1, bit1)),
+                                      _mm_and_si128(s2, bit2));
+        __m128i index2 = _mm_or_si128(_mm_or_si128(_mm_and_si128(s1, bit0),
+                                                   _mm_and_si128(s2, bit1)),
+                                      _mm_and_si128(s3, bit2));
+
+        // Determine the transparent pixels of both playfields
+        __m128i t1 = _mm_cmpeq_epi8(index1, zero);
+        __m128i t2 = _mm_cmpeq_epi8(index2, zero);
+
+        // Pick PF2 if it is solid and PF1 is either behind or transparent
+        __m128i sel2 = prio ? _mm_cmpeq_epi8(t2, zero) : _mm_andnot_si128(t2, t1);
+        __m128i col1 = _mm_and_si128(index1, mask1);
+        __m128i col2 = _mm_and_si128(_mm_or_si128(index2, bit3), mask2);
+        __m128i col = _mm_or_si128(_mm_and_si128(sel2, col2), _mm_andnot_si128(sel2, col1));
+
+        _mm_storeu_si128((__m128i *)(iBuffer + from), col);
+        _mm_storeu_si128((__m128i *)(mBuffer + from), col);
+
+        __m128i lo = depth(_mm_unpacklo_epi8(t1, t1), _mm_unpacklo_epi8(t2, t2));
+        __m128i hi = depth(_mm_unpackhi_epi8(t1, t1), _mm_unpackhi_epi8(t2, t2));
+        _mm_storeu_si128((__m128i *)(zBuffer + from), lo);
+        _mm_storeu_si128((__m128i *)(zBuffer + from + 8), hi);
+    }
+
+    return from;
+}
+
+#else
+
+Pixel
+Denise::translateSPFSSE(Pixel from, Pixel to, PFState &state)
+{
+    return from;
+}
+
+template <bool prio> Pixel
+Denise::translateDPFSSE(Pixel from, Pixel to, PFState &state)
+{
+    return from;
+}
+
+#endif
+
 void
 Denise::drawSprites()
 {
@@ -1036,8 +1135,12 @@ Denise::checkP2PCollisions()
     u8 compare1 = mvbp1() & enabled1;
     u8 compare2 = mvbp2() & enabled2;
 
-    // Check all pixels one by one
-    for (isize pos = 0; pos < HPIXELS; pos++) {
+    // Skip all chunks of 16 pixels without a collision
+    Pixel start = 0;
+    if constexpr (!NO_SSE) start = findP2PCollisionSSE(enabled1 | enabled2, compare1 | compare2);
+
+    // Check the remaining pixels one by one
+    for (isize pos = start; pos < HPIXELS; pos++) {
 
         u16 b = bBuffer[pos];
 
@@ -1054,12 +1157,57 @@ Denise::checkP2PCollisions()
     }
 }
 
+#if defined(__SSE2__)
+
+Pixel
+Denise::findP2PCollisionSSE(u8 enabled, u8 compare)
+{
+    /* Because the enable masks of both playfields are disjoint, both
+     * comparisons of the scalar code can be merged into a single one.
+     */
+    const __m128i e = _mm_set1_epi8((char)enabled);
+    const __m128i c = _mm_set1_epi8((char)compare);
+
+    Pixel pos = 0;
+    for (; pos + 16 <= HPIXELS; pos += 16) {
+
+        __m128i b = _mm_loadu_si128((__m128i *)(bBuffer + pos));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(b, e), c))) break;
+    }
+
+    return pos;
+}
+
+#else
+
+Pixel
+Denise::findP2PCollisionSSE(u8 enabled, u8 compare)
+{
+    return 0;
+}
+
+#endif
+
 void
 Denise::vsyncHandler()
 {
     hflop = true;
     pixelEngine.vsyncHandler();
     debugger.vsyncHandler();
+    updateSkipFrame();
+}
+
+void
+Denise::updateSkipFrame()
+{
+    if (amiga.inWarpMode() && config.warpFrameSkip) {
+
+        skipFrame = true;
+
+    } else {
+
+        skipFrame = agnus.frame.nr % config.frameSkipInterval < config.frameSkip;
+    }
 }
 
 void
@@ -1087,6 +1235,9 @@ Denise::beginOfLine(isize vpos)
 void
 Denise::endOfLine(isize vpos)
 {
+    // Take the fast path if the frame is not rendered
+    if (skipFrame) { skipLine(vpos); return; }
+
     // Check if we are below the VBLANK area
     if (vpos >= 26) {
 
@@ -1104,11 +1255,6 @@ Denise::endOfLine(isize vpos)
 
         // Synthesize RGBA values and write the result into the frame buffer
         pixelEngine.colorize(vpos);
-
-        // Remove certain graphics layers if requested
-        if (config.hiddenLayers) {
-            pixelEngine.hide(vpos, config.hiddenLayers, config.hiddenLayerAlpha);
-        }
         
     } else {
         
@@ -1125,10 +1271,51 @@ Denise::endOfLine(isize vpos)
     assert(sprChanges[3].isEmpty());
 
     // Invoke the DMA debugger
-    dmaDebugger.computeOverlay();
+    if constexpr (!NO_DMA_DEBUGGER) {
+        if (dmaDebugger.isEnabled()) dmaDebugger.computeOverlay();
+    }
     
     // Encode a HIRES / LORES marker in the first HBLANK pixel
-    *denise.pixelEngine.pixelAddr(HBLANK_MIN * 4) = hires() ? 0 : -1;
+    pixelEngine.markLine(hires());
+}
+
+void
+Denise::skipLine(isize vpos)
+{
+    if (vpos >= 26) {
+
+        // The z buffer is only needed if sprites are drawn
+        if (wasArmed) {
+
+            translate();
+
+        } else {
+
+            hideBitplanes();
+            conChanges.clear();
+        }
+
+        // Update the sprite registers and check for sprite collisions
+        drawSprites();
+
+        // Perform playfield-playfield collision check (if enabled)
+        if (config.clxPlfPlf) checkP2PCollisions();
+
+    } else {
+
+        drawSprites();
+        conChanges.clear();
+    }
+
+    // Apply all color register changes without colorizing the line
+    pixelEngine.endOfVBlankLine();
+
+    assert(conChanges.isEmpty());
+    assert(pixelEngine.colChanges.isEmpty());
+    assert(sprChanges[0].isEmpty());
+    assert(sprChanges[1].isEmpty());
+    assert(sprChanges[2].isEmpty());
+    assert(sprChanges[3].isEmpty());
 }
 
 template void Denise::drawOdd<false>(Pixel offset);
@@ -1138,3 +1325,5 @@ template void Denise::drawEven<true>(Pixel offset);
 
 template void Denise::translateDPF<true>(Pixel from, Pixel to, PFState &state);
 template void Denise::translateDPF<false>(Pixel from, Pixel to, PFState &state);
+template Pixel Denise::translateDPFSSE<true>(Pixel from, Pixel to, PFState &state);
+template Pixel Denise::translateDPFSSE<false>(Pixel from, Pixel to, PFState &state);
@@ -21,6 +21,7 @@
 class Denise : public SubComponent {
     
     friend class DeniseDebugger;
+    friend class RegressionTester;
     
     // Current configuration
     DeniseConfig config = {};
@@ -52,6 +53,13 @@ public:
     // Denise has been executed up to this clock cycle
     Cycle clock = 0;
 
+    /* Indicates if the current frame is rendered. In skipped frames, Denise
+     * only performs the operations that affect the emulated state, i.e.,
+     * the collision checks and the register change bookkeeping. The frame
+     * buffer is not touched.
+     */
+    bool skipFrame = false;
+
 
     //
     // Registers
@@ -422,8 +430,6 @@ public:
 
     // Extracts a bit slice from the shift registers
     void extractSlices(u8 slices[16]);
-    void extractSlicesOdd(u8 slices[16]);
-    void extractSlicesEven(u8 slices[16]);
 
     
     //
@@ -453,6 +459,9 @@ private:
     // Translates the bitplane data to color register indices
     void translate();
 
+    // Wipes out the bitplane data of all hidden bitplanes
+    void hideBitplanes();
+
     // Called by translate() in single-playfield mode
     void translateSPF(Pixel from, Pixel to, PFState &state);
 
@@ -462,6 +471,13 @@ private:
     // Called by translateDPF(...)
     template <bool prio> void translateDPF(Pixel from, Pixel to, PFState &state);
 
+    /* Vectorized versions of the translation functions. They process chunks of
+     * 16 pixels and return the first pixel that has not been translated. The
+     * remaining pixels are translated by the scalar functions above.
+     */
+    Pixel translateSPFSSE(Pixel from, Pixel to, PFState &state);
+    template <bool prio> Pixel translateDPFSSE(Pixel from, Pixel to, PFState &state);
+
     
     //
     // Drawing the border
@@ -492,6 +508,9 @@ public:
     // Checks the z buffer and returns true if a sprite pixel is visible
     bool spritePixelIsVisible(Pixel hpos) const;
 
+    // Checks if sprite pixels may have been drawn in the current rasterline
+    bool spritesDrawn() const { return wasArmed != 0; }
+
 private:
     
     // Draws all sprites
@@ -525,6 +544,12 @@ private:
     // Checks for playfield-playfield collisions in the current rasterline
     void checkP2PCollisions();
 
+    /* Vectorized front end of checkP2PCollisions(). The function returns the
+     * beginning of the first 16 pixel chunk containing a collision or the
+     * first pixel that has not been checked.
+     */
+    Pixel findP2PCollisionSSE(u8 enabled, u8 compare);
+
 
     //
     // Delegation methods
@@ -540,6 +565,17 @@ public:
 
     // Called by Agnus at the end of a rasterline
     void endOfLine(isize vpos);
+
+    // Indicates if the current frame is rendered
+    bool isSkippingFrame() const { return skipFrame; }
+
+private:
+
+    // Called by endOfLine() in frames that are not rendered
+    void skipLine(isize vpos);
+
+    // Decides whether the upcoming frame will be rendered
+    void updateSkipFrame();
     
     
     //
@@ -37,6 +37,13 @@ Denise::_inspect() const
         for (isize i = 0; i < 6; i++) {
             info.bpldat[i] = bpldat[i];
         }
+
+        /* Wait until the render thread has applied all color register
+         * changes. Syncing requires non-const access which we get via the
+         * reference provided by SubComponent.
+         */
+        SubComponent::pixelEngine.sync();
+        
         for (isize i = 0; i < 32; i++) {
             info.colorReg[i] = pixelEngine.getColor(i);
             info.color[i] = pixelEngine.getRGBA(i);
@@ -67,6 +74,10 @@ Denise::_dump(dump::Category category, std::ostream& os) const
         os << bol(config.clxSprSpr) << std::endl;
         os << tab("clxSprSpr");
         os << bol(config.clxSprSpr) << std::endl;
+        os << tab("Frame skip");
+        os << dec(config.frameSkip) << " / " << dec(config.frameSkipInterval) << std::endl;
+        os << tab("Skip frames in warp mode");
+        os << bol(config.warpFrameSkip) << std::endl;
     }
     
     if (category & dump::Registers) {
@@ -90,6 +90,15 @@ typedef struct
 
     // Checks for playfield-playfield collisions
     bool clxPlfPlf;
+
+    // Number of frames that are not rendered in each skip interval
+    u8 frameSkip;
+
+    // Length of a skip interval in frames
+    u8 frameSkipInterval;
+
+    // Skips the rendering of all frames in warp mode
+    bool warpFrameSkip;
 }
 DeniseConfig;
 
@@ -10,12 +10,20 @@
 #include "config.h"
 #include "PixelEngine.h"
 #include "Agnus.h"
+#include "Amiga.h"
 #include "Colors.h"
 #include "Denise.h"
 #include "DmaDebugger.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <fstream>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 PixelEngine::PixelEngine(Amiga& ref) : SubComponent(ref)
 {
     // Allocate frame buffers
@@ -32,9 +40,20 @@ PixelEngine::PixelEngine(Amiga& ref) : SubComponent(ref)
 
 PixelEngine::~PixelEngine()
 {
+    stopRenderThread();
+
     delete[] emuTexture[0].data;
     delete[] emuTexture[1].data;
     delete[] noise;
+    delete[] overrideRgba;
+    delete[] stagedRgba;
+
+    for (isize i = 0; i < 2; i++) {
+
+        delete[] indexTexture[i].data;
+        delete[] indexTexture[i].sprites;
+        delete[] indexTexture[i].lines;
+    }
 }
 
 void
@@ -63,9 +82,12 @@ PixelEngine::_initialize()
 void
 PixelEngine::_reset(bool hard)
 {
+    sync();
+
     RESET_SNAPSHOT_ITEMS(hard)
     
     frameBuffer = & emuTexture[0];
+    indexBuffer = & indexTexture[0];
     updateRGBA();
 }
 
@@ -76,6 +98,18 @@ PixelEngine::didLoadFromBuffer(const u8 *buffer)
     return 0;
 }
 
+void
+PixelEngine::_powerOff()
+{
+    sync();
+}
+
+void
+PixelEngine::_pause()
+{
+    sync();
+}
+
 void
 PixelEngine::_powerOn()
 {
@@ -100,6 +134,8 @@ PixelEngine::getDefaultConfig()
     defaults.brightness = 50;
     defaults.contrast = 100;
     defaults.saturation = 50;
+    defaults.frameFormat = FRAME_FORMAT_RGBA;
+    defaults.renderThread = false;
     
     return defaults;
 }
@@ -114,6 +150,8 @@ PixelEngine::resetConfig()
     setConfigItem(OPT_BRIGHTNESS, defaults.brightness);
     setConfigItem(OPT_CONTRAST, defaults.contrast);
     setConfigItem(OPT_SATURATION, defaults.saturation);
+    setConfigItem(OPT_FRAME_FORMAT, defaults.frameFormat);
+    setConfigItem(OPT_RENDER_THREAD, defaults.renderThread);
 }
 
 i64
@@ -125,6 +163,8 @@ PixelEngine::getConfigItem(Option option) const
         case OPT_BRIGHTNESS:  return config.brightness;
         case OPT_CONTRAST:    return config.contrast;
         case OPT_SATURATION:  return config.saturation;
+        case OPT_FRAME_FORMAT:  return config.frameFormat;
+        case OPT_RENDER_THREAD: return config.renderThread;
 
         default:
             fatalError;
@@ -176,6 +216,23 @@ PixelEngine::setConfigItem(Option option, i64 value)
             updateRGBA();
             return;
 
+        case OPT_FRAME_FORMAT:
+
+            if (!FrameFormatEnum::isValid(value)) {
+                throw VAError(ERROR_OPT_INVARG, FrameFormatEnum::keyList());
+            }
+
+            sync();
+            if (value != FRAME_FORMAT_RGBA) allocIndexedBuffers();
+            config.frameFormat = (FrameFormat)value;
+            return;
+
+        case OPT_RENDER_THREAD:
+
+            config.renderThread = (bool)value;
+            config.renderThread ? startRenderThread() : stopRenderThread();
+            return;
+
         default:
             fatalError;
     }
@@ -198,6 +255,40 @@ PixelEngine::setColor(isize reg, u16 value)
 
 void
 PixelEngine::updateRGBA()
+{
+    // Wait until the render thread stops using the lookup tables
+    sync();
+
+    if (overrideRgba) {
+
+        // Use the user-provided table
+        std::memcpy(rgba, overrideRgba, sizeof(rgba));
+
+    } else {
+
+        // Look up the table of the selected palette
+        auto &entry = paletteCache[config.palette];
+
+        if (!entry.valid ||
+            entry.brightness != config.brightness ||
+            entry.contrast != config.contrast ||
+            entry.saturation != config.saturation) {
+
+            computeRGBA(entry.rgba);
+            entry.valid = true;
+            entry.brightness = config.brightness;
+            entry.contrast = config.contrast;
+            entry.saturation = config.saturation;
+        }
+        std::memcpy(rgba, entry.rgba, sizeof(rgba));
+    }
+
+    // Update all RGBA values that are cached in indexedRgba[]
+    for (isize i = 0; i < 32; i++) setColor(i, colreg[i]);
+}
+
+void
+PixelEngine::computeRGBA(u32 *table) const
 {
     // Iterate through all 4096 colors
     for (u16 col = 0x000; col <= 0xFFF; col++) {
@@ -211,15 +302,12 @@ PixelEngine::updateRGBA()
         adjustRGB(r, g, b);
 
         // Write the result into the register lookup table
-        rgba[col] = HI_HI_LO_LO(0xFF, b, g, r);
+        table[col] = HI_HI_LO_LO(0xFF, b, g, r);
     }
-
-    // Update all RGBA values that are cached in indexedRgba[]
-    for (isize i = 0; i < 32; i++) setColor(i, colreg[i]);
 }
 
 void
-PixelEngine::adjustRGB(u8 &r, u8 &g, u8 &b)
+PixelEngine::adjustRGB(u8 &r, u8 &g, u8 &b) const
 {
     // Normalize adjustment parameters
     double brightness =  config.brightness - 50.0;
@@ -295,6 +383,45 @@ PixelEngine::adjustRGB(u8 &r, u8 &g, u8 &b)
     b = u8(newB);
 }
 
+void
+PixelEngine::setPaletteOverride(const u32 *table)
+{
+    {   SYNCHRONIZED
+
+        if (table) {
+
+            if (!stagedRgba) stagedRgba = new u32[4096];
+            std::memcpy(stagedRgba, table, 4096 * sizeof(u32));
+
+        } else {
+
+            delete[] stagedRgba;
+            stagedRgba = nullptr;
+        }
+        overrideChanged = true;
+    }
+}
+
+void
+PixelEngine::applyOverride()
+{
+    {   SYNCHRONIZED
+
+        if (stagedRgba) {
+
+            if (!overrideRgba) overrideRgba = new u32[4096];
+            std::memcpy(overrideRgba, stagedRgba, 4096 * sizeof(u32));
+
+        } else {
+
+            delete[] overrideRgba;
+            overrideRgba = nullptr;
+        }
+        overrideChanged = false;
+    }
+    updateRGBA();
+}
+
 ScreenBuffer
 PixelEngine::getStableBuffer()
 {
@@ -305,6 +432,16 @@ PixelEngine::getStableBuffer()
     }
 }
 
+IndexedBuffer
+PixelEngine::getStableIndexedBuffer()
+{
+    if (indexBuffer == &indexTexture[0]) {
+        return indexTexture[1];
+    } else {
+        return indexTexture[0];
+    }
+}
+
 void
 PixelEngine::swapBuffers()
 {
@@ -314,9 +451,26 @@ PixelEngine::swapBuffers()
     frameBuffer = (frameBuffer == &emuTexture[0]) ? &emuTexture[1] : &emuTexture[0];
     frameBuffer->longFrame = agnus.frame.lof;
 
+    indexBuffer = (indexBuffer == &indexTexture[0]) ? &indexTexture[1] : &indexTexture[0];
+    indexBuffer->longFrame = agnus.frame.lof;
+
     unlockStableBuffer();
 }
 
+void
+PixelEngine::allocIndexedBuffers()
+{
+    for (isize i = 0; i < 2; i++) {
+
+        if (indexTexture[i].data) continue;
+
+        indexTexture[i].data = new u8[PIXELS]();
+        indexTexture[i].sprites = new u8[PIXELS]();
+        indexTexture[i].lines = new IndexedLine[VPIXELS]();
+        indexTexture[i].longFrame = true;
+    }
+}
+
 u32 *
 PixelEngine::getNoise() const
 {
@@ -340,18 +494,51 @@ PixelEngine::pixelAddr(isize pixel) const
 void
 PixelEngine::vsyncHandler()
 {
-    swapBuffers();
-    dmaDebugger.vSyncHandler();
+    // Wait until all lines of this frame have been drawn
+    sync();
+
+    // Keep the last rendered frame stable if this frame has been skipped
+    if (!denise.isSkippingFrame()) swapBuffers();
+
+    // Activate a new palette override
+    if (overrideChanged) applyOverride();
+
+    if constexpr (!NO_DMA_DEBUGGER) {
+        if (dmaDebugger.isEnabled() || dmaDebugger.isRecording()) dmaDebugger.vSyncHandler();
+    }
 }
 
 void
 PixelEngine::endOfVBlankLine()
 {
-    // Apply all color register changes that happened in this line
-    for (isize i = 0, end = colChanges.end(); i < end; i++) {
-        applyRegisterChange(colChanges.elements[i]);
+    if (isPipelined()) {
+
+        // Let the render thread apply the register changes
+        LineJob &job = prepareJob();
+        job.line = agnus.pos.v;
+        job.colorize = false;
+        job.changes = colChanges;
+        colChanges.clear();
+        return;
+    }
+
+    sync();
+    applyRegisterChanges(colChanges);
+}
+
+void
+PixelEngine::markLine(bool hires)
+{
+    if (isPipelined()) {
+
+        assert(pending);
+        pending->marked = true;
+        pending->hires = hires;
+        return;
     }
-    colChanges.clear();
+
+    sync();
+    *pixelAddr(HBLANK_MIN * 4) = hires ? 0 : -1;
 }
 
 void
@@ -376,9 +563,74 @@ PixelEngine::applyRegisterChange(const RegChange &change)
     }
 }
 
+void
+PixelEngine::applyRegisterChanges(RegChangeRecorder<128> &changes)
+{
+    // Apply all color register changes that happened in this line
+    for (isize i = 0, end = changes.end(); i < end; i++) {
+        applyRegisterChange(changes.elements[i]);
+    }
+    changes.clear();
+}
+
 void
 PixelEngine::colorize(isize line)
 {
+    auto &deniseConfig = denise.getConfig();
+
+    if (isPipelined()) {
+
+        // Hand the line over to the render thread
+        LineJob &job = prepareJob();
+        job.line = line;
+        job.colorize = true;
+        job.sprites = denise.spritesDrawn();
+        job.hires = denise.hires();
+        job.hiddenLayers = deniseConfig.hiddenLayers;
+        job.hiddenLayerAlpha = deniseConfig.hiddenLayerAlpha;
+        job.changes = colChanges;
+        std::memcpy(job.bBuffer, denise.bBuffer, sizeof(job.bBuffer));
+        std::memcpy(job.iBuffer, denise.iBuffer, sizeof(job.iBuffer));
+        std::memcpy(job.mBuffer, denise.mBuffer, sizeof(job.mBuffer));
+        std::memcpy(job.zBuffer, denise.zBuffer, sizeof(job.zBuffer));
+        colChanges.clear();
+        return;
+    }
+
+    sync();
+
+    // Read the source data directly from Denise
+    bbuf = denise.bBuffer;
+    ibuf = denise.iBuffer;
+    mbuf = denise.mBuffer;
+    zbuf = denise.zBuffer;
+    lineHasSprites = denise.spritesDrawn();
+    lineIsHires = denise.hires();
+
+    colorize(line, colChanges);
+
+    // Remove certain graphics layers if requested
+    if (deniseConfig.hiddenLayers) {
+        hide(line, deniseConfig.hiddenLayers, deniseConfig.hiddenLayerAlpha);
+    }
+}
+
+void
+PixelEngine::colorize(isize line, RegChangeRecorder<128> &changes)
+{
+    // Export the color register indices if requested
+    if (config.frameFormat != FRAME_FORMAT_RGBA) {
+
+        record(line, changes);
+
+        // Skip the RGBA conversion if the consumer only wants indices
+        if (config.frameFormat == FRAME_FORMAT_INDEXED) {
+
+            applyRegisterChanges(changes);
+            return;
+        }
+    }
+
     // Jump to the first pixel in the specified line in the active frame buffer
     u32 *dst = frameBuffer->data + line * HPIXELS;
     Pixel pixel = 0;
@@ -387,13 +639,13 @@ PixelEngine::colorize(isize line)
     u16 hold = colreg[0];
 
     // Add a dummy register change to ensure we draw until the line end
-    colChanges.insert(HPIXELS, RegChange { SET_NONE, 0 } );
+    changes.insert(HPIXELS, RegChange { SET_NONE, 0 } );
 
     // Iterate over all recorded register changes
-    for (isize i = 0, end = colChanges.end(); i < end; i++) {
+    for (isize i = 0, end = changes.end(); i < end; i++) {
 
-        Pixel trigger = (Pixel)colChanges.keys[i];
-        RegChange &change = colChanges.elements[i];
+        Pixel trigger = (Pixel)changes.keys[i];
+        RegChange &change = changes.elements[i];
 
         // Colorize a chunk of pixels
         if (hamMode) {
@@ -408,7 +660,7 @@ PixelEngine::colorize(isize line)
     }
 
     // Clear the history cache
-    colChanges.clear();
+    changes.clear();
 
     // Wipe out the HBLANK area
     for (pixel = 4 * HBLANK_MIN; pixel <= 4 * HBLANK_MAX; pixel++) {
@@ -419,7 +671,21 @@ PixelEngine::colorize(isize line)
 void
 PixelEngine::colorize(u32 *dst, Pixel from, Pixel to)
 {
-    u8 *mbuf = denise.mBuffer;
+#if defined(__AVX2__)
+
+    // Colorize chunks of 8 pixels with a single gather operation
+    if constexpr (!NO_SSE) {
+
+        for (; from + 8 <= to; from += 8) {
+
+            __m128i index = _mm_loadl_epi64((__m128i *)(mbuf + from));
+            __m256i col = _mm256_i32gather_epi32((const int *)indexedRgba,
+                                                 _mm256_cvtepu8_epi32(index), 4);
+            _mm256_storeu_si256((__m256i *)(dst + from), col);
+        }
+    }
+
+#endif
 
     for (Pixel i = from; i < to; i++) {
         dst[i] = indexedRgba[mbuf[i]];
@@ -429,51 +695,89 @@ PixelEngine::colorize(u32 *dst, Pixel from, Pixel to)
 void
 PixelEngine::colorizeHAM(u32 *dst, Pixel from, Pixel to, u16& ham)
 {
-    u8 *bbuf = denise.bBuffer;
-    u8 *ibuf = denise.iBuffer;
-    u8 *mbuf = denise.mBuffer;
+    // Bits kept and position of the new bits (indexed by the control bits)
+    static constexpr u16 keep[4] = { 0x000, 0xFF0, 0x0FF, 0xF0F };
+    static constexpr u8 shift[4] = { 0, 0, 8, 4 };
 
-    for (Pixel i = from; i < to; i++) {
+    for (Pixel i = from; i < to; ) {
 
+        u8 b = bbuf[i];
         u8 index = ibuf[i];
         assert(isRgbaIndex(index));
 
-        switch ((bbuf[i] >> 4) & 0b11) {
+        // Get color from register or modify a single color component
+        if (u8 ctrl = (b >> 4) & 0b11) {
+            ham = (ham & keep[ctrl]) | (u16)((index & 0b1111) << shift[ctrl]);
+        } else {
+            ham = colreg[index];
+        }
 
-            case 0b00: // Get color from register
+        /* Repeating a HAM operation doesn't change the hold register. Hence,
+         * all pixels in a run of identical values share the same color. Such
+         * runs are frequent, e.g., in lores mode where each pixel is doubled.
+         */
+        u32 col = rgba[ham];
+        Pixel end = i + 1;
+        while (end < to && bbuf[end] == b && ibuf[end] == index) end++;
+        while (i < end) dst[i++] = col;
+    }
 
-                ham = colreg[index];
-                break;
+    // Synthesize sprite pixels
+    if (lineHasSprites) {
 
-            case 0b01: // Modify blue
+        for (Pixel i = from; i < to; i++) {
+            if (Denise::isSpritePixel(zbuf[i])) dst[i] = rgba[colreg[mbuf[i]]];
+        }
+    }
+}
 
-                ham &= 0xFF0;
-                ham |= (index & 0b1111);
-                break;
+void
+PixelEngine::record(isize line, const RegChangeRecorder<128> &changes)
+{
+    u8 *dst = indexBuffer->data + line * HPIXELS;
+    u8 *spr = indexBuffer->sprites + line * HPIXELS;
+    IndexedLine &info = indexBuffer->lines[line];
 
-            case 0b10: // Modify red
+    auto copy = [&](Pixel from, Pixel to, bool ham) {
 
-                ham &= 0x0FF;
-                ham |= (index & 0b1111) << 8;
-                break;
+        if (!ham) {
 
-            case 0b11: // Modify green
+            std::memcpy(dst + from, mbuf + from, to - from);
+            return;
+        }
 
-                ham &= 0xF0F;
-                ham |= (index & 0b1111) << 4;
-                break;
+        for (Pixel i = from; i < to; i++) {
 
-            default:
-                fatalError;
+            dst[i] = (bbuf[i] & 0x30) | (ibuf[i] & 0x0F);
+            spr[i] = Denise::isSpritePixel(zbuf[i]) ? mbuf[i] : 0;
         }
+    };
 
-        // Synthesize pixel
-        if (denise.spritePixelIsVisible(i)) {
-            dst[i] = rgba[colreg[mbuf[i]]];
-        } else {
-            dst[i] = rgba[ham];
-        }
+    // Save the state at the beginning of the line
+    info.drawn = true;
+    info.hires = lineIsHires;
+    info.ham = hamMode;
+    info.numChanges = 0;
+    std::memcpy(info.colreg, colreg, sizeof(colreg));
+
+    // Copy the color register indices chunk by chunk
+    bool ham = hamMode;
+    Pixel pixel = 0;
+
+    for (isize i = 0, end = changes.end(); i < end; i++) {
+
+        Pixel trigger = (Pixel)changes.keys[i];
+        const RegChange &change = changes.elements[i];
+
+        if (change.addr == 0) continue;
+
+        copy(pixel, trigger, ham);
+        pixel = trigger;
+
+        if (change.addr == 0x100) ham = Denise::ham(change.value);
+        info.changes[info.numChanges++] = { (i16)trigger, (u16)change.addr, change.value };
     }
+    copy(pixel, HPIXELS, ham);
 }
 
 void
@@ -483,7 +787,7 @@ PixelEngine::hide(isize line, u16 layers, u8 alpha)
 
     for (Pixel i = 0; i < HPIXELS; i++) {
 
-        u16 z = denise.zBuffer[i];
+        u16 z = zbuf[i];
 
         // Check for case 1: A sprite is visible
         if (Denise::isSpritePixel(z)) {
@@ -519,3 +823,242 @@ PixelEngine::hide(isize line, u16 layers, u8 alpha)
         p[i] = 0xFF000000 | newb << 16 | newg << 8 | newr;
     }
 }
+
+bool
+PixelEngine::isPipelined() const
+{
+    /* The DMA debugger draws into the rasterlines on the emulator thread and
+     * the debugger reads the color registers while sprites are drawn. Hence,
+     * all lines are processed synchronously in both cases.
+     */
+    return jobs && !dmaDebugger.getConfig().enabled && !amiga.inDebugMode();
+}
+
+void
+PixelEngine::startRenderThread()
+{
+    if (jobs) return;
+
+    jobs = new LineJob[queueSize];
+    produced = 0;
+    consumed = 0;
+    pending = nullptr;
+
+    renderThread = std::thread(&PixelEngine::renderLoop, this);
+}
+
+void
+PixelEngine::stopRenderThread()
+{
+    if (!jobs) return;
+
+    // Ask the render thread to terminate
+    LineJob &job = prepareJob();
+    job.quit = true;
+    publishJob();
+
+    renderThread.join();
+
+    delete[] jobs;
+    jobs = nullptr;
+}
+
+PixelEngine::LineJob &
+PixelEngine::prepareJob()
+{
+    assert(jobs);
+
+    publishJob();
+
+    // Wait for a free slot
+    isize p = produced.load();
+    for (isize c = consumed.load(); p - c >= queueSize; c = consumed.load()) {
+        consumed.wait(c);
+    }
+
+    pending = &jobs[p % queueSize];
+    pending->marked = false;
+    pending->quit = false;
+
+    return *pending;
+}
+
+void
+PixelEngine::publishJob()
+{
+    if (pending) {
+
+        pending = nullptr;
+        produced.fetch_add(1);
+        produced.notify_one();
+    }
+}
+
+void
+PixelEngine::sync()
+{
+    if (!jobs) return;
+
+    publishJob();
+
+    // Wait until the render thread has caught up
+    for (isize c = consumed.load(); c != produced.load(); c = consumed.load()) {
+        consumed.wait(c);
+    }
+}
+
+void
+PixelEngine::renderLoop()
+{
+    for (isize c = consumed.load(); ; c = consumed.load()) {
+
+        // Wait for the next job
+        for (isize p = produced.load(); p == c; p = produced.load()) {
+            produced.wait(p);
+        }
+
+        LineJob &job = jobs[c % queueSize];
+        if (job.quit) break;
+
+        if (job.colorize) {
+
+            bbuf = job.bBuffer;
+            ibuf = job.iBuffer;
+            mbuf = job.mBuffer;
+            zbuf = job.zBuffer;
+            lineHasSprites = job.sprites;
+            lineIsHires = job.hires;
+
+            colorize(job.line, job.changes);
+
+            // Remove certain graphics layers if requested
+            if (job.hiddenLayers) hide(job.line, job.hiddenLayers, job.hiddenLayerAlpha);
+
+        } else {
+
+            applyRegisterChanges(job.changes);
+        }
+
+        // Encode a HIRES / LORES marker in the first HBLANK pixel
+        if (job.marked) {
+            frameBuffer->data[job.line * HPIXELS + HBLANK_MIN * 4] = job.hires ? 0 : -1;
+        }
+
+        consumed.fetch_add(1);
+        consumed.notify_one();
+    }
+
+    // Acknowledge the termination request
+    consumed.fetch_add(1);
+    consumed.notify_one();
+}
+
+void
+PixelEngine::expand(const IndexedBuffer &buffer, u32 *dst) const
+{
+    assert(buffer.data);
+
+    for (isize line = 0; line < VPIXELS; line++) {
+        expand(buffer, line, dst + line * HPIXELS);
+    }
+}
+
+void
+PixelEngine::expand(const IndexedBuffer &buffer, isize line, u32 *dst) const
+{
+    assert(buffer.data);
+    assert(line < VPIXELS);
+
+    const u8 *src = buffer.data + line * HPIXELS;
+    const u8 *spr = buffer.sprites + line * HPIXELS;
+    const IndexedLine &info = buffer.lines[line];
+
+    // Lines in the VBLANK area contain no data
+    if (!info.drawn) {
+
+        for (Pixel i = 0; i < HPIXELS; i++) dst[i] = rgbaVBlank;
+        return;
+    }
+
+    // Setup a local copy of the color registers and the RGBA lookup table
+    u16 regs[32];
+    u32 table[rgbaIndexCnt];
+
+    auto setColor = [&](isize reg, u16 value) {
+
+        u8 r = (value & 0xF00) >> 8;
+        u8 g = (value & 0x0F0) >> 4;
+        u8 b = (value & 0x00F);
+
+        regs[reg] = value & 0xFFF;
+        table[reg] = rgba[value & 0xFFF];
+        table[reg + 32] = rgba[((r / 2) << 8) | ((g / 2) << 4) | (b / 2)];
+    };
+
+    std::memcpy(table, indexedRgba, sizeof(table));
+    for (isize i = 0; i < 32; i++) setColor(i, info.colreg[i]);
+
+    // Replay all recorded register changes
+    bool ham = info.ham;
+    u16 hold = regs[0];
+    Pixel pixel = 0;
+
+    for (isize i = 0; i <= info.numChanges; i++) {
+
+        Pixel trigger = i < info.numChanges ? info.changes[i].pixel : HPIXELS;
+
+        // Expand a chunk of pixels
+        if (ham) {
+            expandHAM(src, spr, dst, pixel, trigger, regs, hold);
+        } else {
+            expand(src, dst, pixel, trigger, table);
+        }
+        pixel = trigger;
+
+        if (i == info.numChanges) break;
+
+        // Perform the register change
+        auto &change = info.changes[i];
+        if (change.addr == 0x100) {
+            ham = Denise::ham(change.value);
+        } else {
+            setColor((change.addr - 0x180) >> 1, change.value);
+        }
+    }
+
+    // Wipe out the HBLANK area
+    for (pixel = 4 * HBLANK_MIN; pixel <= 4 * HBLANK_MAX; pixel++) {
+        dst[pixel] = rgbaHBlank;
+    }
+
+    // Restore the HIRES / LORES marker
+    dst[4 * HBLANK_MIN] = info.hires ? 0 : -1;
+}
+
+void
+PixelEngine::expand(const u8 *src, u32 *dst, Pixel from, Pixel to, const u32 *table) const
+{
+    for (Pixel i = from; i < to; i++) {
+        dst[i] = table[src[i]];
+    }
+}
+
+void
+PixelEngine::expandHAM(const u8 *src, const u8 *spr, u32 *dst,
+                       Pixel from, Pixel to, const u16 *regs, u16 &ham) const
+{
+    for (Pixel i = from; i < to; i++) {
+
+        u8 index = src[i] & 0b1111;
+
+        switch ((src[i] >> 4) & 0b11) {
+
+            case 0b00: ham = regs[index]; break;
+            case 0b01: ham = (ham & 0xFF0) | index; break;
+            case 0b10: ham = (ham & 0x0FF) | index << 8; break;
+            case 0b11: ham = (ham & 0xF0F) | index << 4; break;
+        }
+
+        dst[i] = rgba[spr[i] ? regs[spr[i]] : ham];
+    }
+}
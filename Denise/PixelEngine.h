@@ -13,6 +13,8 @@
 #include "SubComponent.h"
 #include "ChangeRecorder.h"
 #include "Constants.h"
+#include <atomic>
+#include <thread>
 
 class PixelEngine : public SubComponent {
 
@@ -44,6 +46,15 @@ private:
     // Pointer to the "working buffer"
     ScreenBuffer *frameBuffer = &emuTexture[0];
 
+    /* Indexed versions of the two textures. The buffers are allocated when
+     * the indexed frame format gets selected for the first time. They are
+     * swapped together with the RGBA buffers.
+     */
+    IndexedBuffer indexTexture[2] = { };
+
+    // Pointer to the indexed "working buffer"
+    IndexedBuffer *indexBuffer = &indexTexture[0];
+
     // Mutex for synchronizing access to the stable buffer
     util::Mutex bufferMutex;
         
@@ -73,6 +84,27 @@ private:
     
     // Indicates whether HAM mode is switched
     bool hamMode;
+
+    /* Lookup tables for all palettes. A table is computed when its palette is
+     * selected and reused as long as the adjustment parameters do not change.
+     */
+    struct PaletteTable {
+
+        bool valid;
+        isize brightness;
+        isize contrast;
+        isize saturation;
+        u32 rgba[4096];
+    };
+    PaletteTable paletteCache[PALETTE_SEPIA + 1] = { };
+
+    /* Palette override. If set, the override table replaces the computed RGBA
+     * lookup table. New tables are staged and become active with the next
+     * frame, which makes it possible to change colors on a per-frame basis.
+     */
+    u32 *overrideRgba = nullptr;
+    u32 *stagedRgba = nullptr;
+    std::atomic<bool> overrideChanged = false;
     
     
     //
@@ -85,6 +117,72 @@ public:
     RegChangeRecorder<128> colChanges;
 
 
+    //
+    // Render thread
+    //
+
+private:
+
+    /* Input data of the colorization stage. If the render thread is enabled,
+     * the emulator thread copies the line buffers of Denise together with the
+     * recorded color register changes into a job and continues with the next
+     * rasterline. The job is processed later by the render thread.
+     */
+    struct LineJob {
+
+        // The rasterline to process
+        isize line;
+
+        // Indicates if the line is colorized or if only the changes are applied
+        bool colorize;
+
+        // Value of the HIRES / LORES marker (if set)
+        bool marked;
+        bool hires;
+
+        // Indicates if the thread should terminate
+        bool quit;
+
+        // Information about the line
+        bool sprites;
+        u16 hiddenLayers;
+        u8 hiddenLayerAlpha;
+
+        // Recorded color register changes
+        RegChangeRecorder<128> changes;
+
+        // Copies of Denise's line buffers
+        u8 bBuffer[HPIXELS];
+        u8 iBuffer[HPIXELS];
+        u8 mBuffer[HPIXELS];
+        u16 zBuffer[HPIXELS];
+    };
+
+    // Capacity of the job queue
+    static constexpr isize queueSize = 16;
+
+    // Job queue (single producer, single consumer)
+    LineJob *jobs = nullptr;
+
+    // Number of published and processed jobs
+    std::atomic<isize> produced = 0;
+    std::atomic<isize> consumed = 0;
+
+    // The job that has been prepared, but not published yet
+    LineJob *pending = nullptr;
+
+    // The render thread
+    std::thread renderThread;
+
+    // Source buffers of the line that is being colorized
+    const u8 *bbuf = nullptr;
+    const u8 *ibuf = nullptr;
+    const u8 *mbuf = nullptr;
+    const u16 *zbuf = nullptr;
+    bool lineHasSprites = false;
+    bool lineIsHires = false;
+
+
     //
     // Initializing
     //
@@ -153,7 +251,7 @@ private:
     isize _size() override { COMPUTE_SNAPSHOT_SIZE }
     u64 _checksum() override { COMPUTE_SNAPSHOT_CHECKSUM }
     isize _load(const u8 *buffer) override { LOAD_SNAPSHOT_ITEMS }
-    isize _save(u8 *buffer) override { SAVE_SNAPSHOT_ITEMS }
+    isize _save(u8 *buffer) override { sync(); SAVE_SNAPSHOT_ITEMS }
     isize didLoadFromBuffer(const u8 *buffer) override;
 
     
@@ -164,6 +262,8 @@ private:
 private:
 
     void _powerOn() override;
+    void _powerOff() override;
+    void _pause() override;
 
 
     //
@@ -196,8 +296,23 @@ private:
     // Updates the entire RGBA lookup table
     void updateRGBA();
 
-    // Adjusts the RGBA value according to the selected color parameters
-    void adjustRGB(u8 &r, u8 &g, u8 &b);
+    // Computes the RGBA lookup table for the current color parameters
+    void computeRGBA(u32 *table) const;
+
+    // Applies the color adjustment parameters to a single color
+    void adjustRGB(u8 &r, u8 &g, u8 &b) const;
+
+    // Activates a staged palette override
+    void applyOverride();
+
+public:
+
+    /* Overrides the RGBA lookup table. The provided table has to contain 4096
+     * entries, one for each Amiga color. The new colors are used starting
+     * with the next frame. Passing a null pointer removes the override.
+     */
+    void setPaletteOverride(const u32 *table);
+    void clearPaletteOverride() { setPaletteOverride(nullptr); }
 
 
     //
@@ -209,6 +324,9 @@ public:
     // Returns the stable frame buffer
     ScreenBuffer getStableBuffer();
 
+    // Returns the stable indexed frame buffer (data is null if unavailable)
+    IndexedBuffer getStableIndexedBuffer();
+
     // Locks or unlocks the stable buffer
     void lockStableBuffer() { bufferMutex.lock(); }
     void unlockStableBuffer() { bufferMutex.unlock(); }
@@ -218,13 +336,23 @@ public:
     
     // Returns a pointer to randon noise
     u32 *getNoise() const;
+
+private:
     
+    // Allocates the indexed frame buffers
+    void allocIndexedBuffers();
+
+public:
+
     // Returns the frame buffer address of a certain pixel in the current line
     u32 *pixelAddr(isize pixel) const;
 
-    // Called after each line in the VBLANK area
+    // Called after each line in the VBLANK area or in a skipped frame
     void endOfVBlankLine();
 
+    // Encodes a HIRES / LORES marker in the first HBLANK pixel
+    void markLine(bool hires);
+
     // Called after each frame to switch the frame buffers
     void vsyncHandler();
 
@@ -238,6 +366,9 @@ public:
     // Applies a register change
     void applyRegisterChange(const RegChange &change);
 
+    // Applies all recorded register changes and clears the recorder
+    void applyRegisterChanges(RegChangeRecorder<128> &changes);
+
 
     //
     // Synthesizing pixels
@@ -247,20 +378,73 @@ public:
     
     /* Colorizes a rasterline. This function implements the last stage in the
      * graphics pipelile. It translates a line of color register indices into a
-     * line of RGBA values in GPU format.
+     * line of RGBA values in GPU format. If the render thread is enabled, the
+     * line is handed over to this thread.
      */
     void colorize(isize line);
     
 private:
     
+    void colorize(isize line, RegChangeRecorder<128> &changes);
     void colorize(u32 *dst, Pixel from, Pixel to);
     void colorizeHAM(u32 *dst, Pixel from, Pixel to, u16& ham);
+
+    /* Writes a rasterline into the indexed frame buffer. The function stores
+     * the color register indices together with the color registers and all
+     * register changes of the line. It must be called before the recorded
+     * register changes are applied.
+     */
+    void record(isize line, const RegChangeRecorder<128> &changes);
     
     /* Hides some graphics layers. This function is an optional stage applied
      * after colorize(). It can be used to hide some layers for debugging.
      */
-    
-public:
-    
     void hide(isize line, u16 layer, u8 alpha);
+
+
+    //
+    // Running the render thread
+    //
+
+public:
+
+    // Checks if rasterlines are handed over to the render thread
+    bool isPipelined() const;
+
+    // Waits until the render thread has processed all published jobs
+    void sync();
+
+private:
+
+    void startRenderThread();
+    void stopRenderThread();
+
+    // Publishes the pending job and returns a free job slot
+    LineJob &prepareJob();
+
+    // Publishes the pending job
+    void publishJob();
+
+    // Main loop of the render thread
+    void renderLoop();
+
+
+    //
+    // Expanding indexed frames
+    //
+
+public:
+
+    /* Converts an indexed frame into RGBA values. The conversion is carried
+     * out with the RGBA lookup table of this pixel engine. Hence, it reflects
+     * the current palette settings.
+     */
+    void expand(const IndexedBuffer &buffer, u32 *dst) const;
+    void expand(const IndexedBuffer &buffer, isize line, u32 *dst) const;
+
+private:
+
+    void expand(const u8 *src, u32 *dst, Pixel from, Pixel to, const u32 *table) const;
+    void expandHAM(const u8 *src, const u8 *spr, u32 *dst,
+                   Pixel from, Pixel to, const u16 *regs, u16 &ham) const;
 };
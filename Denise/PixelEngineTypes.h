@@ -51,6 +51,35 @@ struct PaletteEnum : util::Reflection<PaletteEnum, Palette>
 };
 #endif
 
+enum_long(FRAME_FORMAT)
+{
+    FRAME_FORMAT_RGBA,
+    FRAME_FORMAT_INDEXED,
+    FRAME_FORMAT_BOTH
+};
+typedef FRAME_FORMAT FrameFormat;
+
+#ifdef __cplusplus
+struct FrameFormatEnum : util::Reflection<FrameFormatEnum, FrameFormat>
+{
+    static long minVal() { return 0; }
+    static long maxVal() { return FRAME_FORMAT_BOTH; }
+    static bool isValid(auto val) { return val >= minVal() && val <= maxVal(); }
+
+    static const char *prefix() { return "FRAME_FORMAT"; }
+    static const char *key(FrameFormat value)
+    {
+        switch (value) {
+                
+            case FRAME_FORMAT_RGBA:     return "RGBA";
+            case FRAME_FORMAT_INDEXED:  return "INDEXED";
+            case FRAME_FORMAT_BOTH:     return "BOTH";
+        }
+        return "???";
+    }
+};
+#endif
+
 //
 // Structures
 //
@@ -62,11 +91,61 @@ typedef struct
 }
 ScreenBuffer;
 
+typedef struct
+{
+    // Pixel position where the change takes effect
+    i16 pixel;
+
+    // Register address (BPLCON0 or one of the color registers)
+    u16 addr;
+
+    // New register value
+    u16 value;
+}
+ColorChange;
+
+typedef struct
+{
+    // Indicates whether the line has been drawn (false in the VBLANK area)
+    bool drawn;
+
+    // Value of the HIRES / LORES marker
+    bool hires;
+
+    // Color registers and HAM mode at the beginning of the line
+    u16 colreg[32];
+    bool ham;
+
+    // Register changes inside the line
+    u8 numChanges;
+    ColorChange changes[128];
+}
+IndexedLine;
+
+/* Indexed frame buffer. For each pixel, a single byte is stored. Outside HAM
+ * mode, this byte is an index into the RGBA lookup table of the pixel engine
+ * (see PixelEngine::indexedRgba). In HAM mode, bits 4 - 5 contain the HAM
+ * control bits and bits 0 - 3 the HAM data bits. Because sprites overlay the
+ * HAM pixels without interrupting the HAM logic, the color registers of
+ * visible sprites are stored in a separate plane (0 = no sprite). This plane
+ * is only written in HAM mode.
+ */
+typedef struct
+{
+    u8 *data;
+    u8 *sprites;
+    IndexedLine *lines;
+    bool longFrame;
+}
+IndexedBuffer;
+
 typedef struct
 {
     Palette palette;
     isize brightness;
     isize contrast;
     isize saturation;
+    FrameFormat frameFormat;
+    bool renderThread;
 }
 PixelEngineConfig;
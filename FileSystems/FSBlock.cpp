@@ -1536,7 +1536,7 @@ FSBlock::addDataBlockRef(u32 first, u32 ref)
             
         case FS_FILEHEADER_BLOCK:
         {
-            std::set<Block> visited;
+            std::unordered_set<Block> visited;
             
             // If this block has space for more references, add it here
             if (getNumDataBlockRefs() < getMaxDataBlockRefs()) {
@@ -11,9 +11,11 @@
 #include "IOUtils.h"
 #include "FSDevice.h"
 #include "MemUtils.h"
+#include "StringUtils.h"
+#include <algorithm>
 #include <climits>
-#include <set>
-#include <stack>
+#include <system_error>
+#include <thread>
 
 void
 FSDevice::init(isize capacity)
@@ -325,7 +327,7 @@ string
 FSDevice::getPath(FSBlock *block)
 {
     string result = "";
-    std::set<Block> visited;
+    std::unordered_set<Block> visited;
  
     while(block) {
 
@@ -358,6 +360,7 @@ FSDevice::createDir(const string &name)
     
     block->setParentDirRef(cdb->nr);
     addHashRef(block->nr);
+    addToDirIndex(block);
     
     return block;
 }
@@ -371,6 +374,7 @@ FSDevice::createFile(const string &name)
     
     block->setParentDirRef(cdb->nr);
     addHashRef(block->nr);
+    addToDirIndex(block);
 
     return block;
 }
@@ -399,7 +403,29 @@ FSDevice::createFile(const string &name, const string &str)
 Block
 FSDevice::seekRef(FSName name)
 {
-    std::set<Block> visited;
+    // Make sure the directory index is up to date
+    if (dirIndexIsDirty) buildDirIndex();
+
+    // Walk the hash chains if the index is incomplete (e.g., due to cycles)
+    if (!dirIndexIsComplete) return seekRefSlow(name);
+
+    auto it = dirIndex.find(indexKey(currentDirKey(), name));
+    if (it == dirIndex.end()) return 0;
+
+    // Double-check the result
+    if (FSBlock *item = hashableBlockPtr(it->second); item && item->isNamed(name)) {
+        return item->nr;
+    }
+
+    // The index is outdated
+    invalidateDirIndex();
+    return seekRefSlow(name);
+}
+
+Block
+FSDevice::seekRefSlow(FSName name)
+{
+    std::unordered_set<Block> visited;
     
     // Only proceed if a hash table is present
     FSBlock *cdb = currentDirBlock();
@@ -424,6 +450,37 @@ FSDevice::seekRef(FSName name)
     return 0;
 }
 
+Block
+FSDevice::seekPathRef(const string &path)
+{
+    // Make sure the directory index is up to date
+    if (dirIndexIsDirty) buildDirIndex();
+    
+    if (dirIndexIsComplete) {
+
+        auto it = dirIndex.find(indexKey(path));
+        return it != dirIndex.end() ? it->second : 0;
+    }
+    
+    // Walk down the directory tree component by component
+    Block oldcd = cd, result = 0;
+    cd = partitions[cp]->rootBlock;
+    
+    for (auto &component : util::split(path, '/')) {
+
+        if (component.empty()) continue;
+        
+        // Only directories can be descended into
+        if (result && !userDirBlockPtr(result)) { result = 0; break; }
+        if (result) cd = result;
+
+        if ((result = seekRefSlow(FSName(component))) == 0) break;
+    }
+    
+    cd = oldcd;
+    return result;
+}
+
 void
 FSDevice::addHashRef(Block nr)
 {
@@ -474,7 +531,7 @@ FSDevice::lastHashBlockInChain(Block start)
 FSBlock *
 FSDevice::lastHashBlockInChain(FSBlock *block)
 {
-    std::set<Block> visited;
+    std::unordered_set<Block> visited;
 
     while (block && visited.find(block->nr) == visited.end()) {
 
@@ -497,7 +554,7 @@ FSDevice::lastFileListBlockInChain(Block start)
 FSBlock *
 FSDevice::lastFileListBlockInChain(FSBlock *block)
 {
-    std::set<Block> visited;
+    std::unordered_set<Block> visited;
 
     while (block && visited.find(block->nr) == visited.end()) {
 
@@ -510,11 +567,80 @@ FSDevice::lastFileListBlockInChain(FSBlock *block)
     return nullptr;
 }
 
+void
+FSDevice::buildDirIndex()
+{
+    dirIndex.clear();
+    dirIndexIsDirty = false;
+    dirIndexIsComplete = false;
+    cdPathRef = 0;
+    
+    if (partitions.empty()) return;
+    
+    // Collect all items
+    std::vector<Block> items;
+    try { collect(partitions[cp]->rootBlock, items); } catch (...) { return; }
+
+    // Register all items by their path
+    dirIndex.reserve(items.size());
+    for (auto &item : items) dirIndex.emplace(indexKey(getPath(item)), item);
+    
+    dirIndexIsComplete = true;
+    debug(FS_DEBUG, "Directory index: %zu items\n", dirIndex.size());
+}
+
+void
+FSDevice::addToDirIndex(FSBlock *block)
+{
+    if (!dirIndexIsDirty && dirIndexIsComplete) {
+        dirIndex.emplace(indexKey(currentDirKey(), block->getName()), block->nr);
+    }
+}
+
+string
+FSDevice::indexKey(const string &path)
+{
+    string result;
+    result.reserve(path.size());
+    
+    for (auto &component : util::split(path, '/')) {
+        
+        if (component.empty()) continue;
+        
+        if (!result.empty()) result += '/';
+        for (auto c : component) result += FSString::capital(c);
+    }
+    return result;
+}
+
+string
+FSDevice::indexKey(const string &dirKey, FSName name)
+{
+    string result = dirKey;
+    
+    if (!result.empty()) result += '/';
+    for (auto c = name.c_str(); *c; c++) result += FSString::capital(*c);
+    return result;
+}
+
+const string &
+FSDevice::currentDirKey()
+{
+    Block nr = currentDirBlock()->nr;
+    
+    if (nr != cdPathRef) {
+        
+        cdPath = indexKey(getPath(nr));
+        cdPathRef = nr;
+    }
+    return cdPath;
+}
+
 void
 FSDevice::collect(Block nr, std::vector<Block> &result, bool recursive)
 {
-    std::stack<Block> remainingItems;
-    std::set<Block> visited;
+    std::vector<Block> remainingItems;
+    std::unordered_set<Block> visited;
     
     // Start with the items in this block
     collectHashedRefs(nr, remainingItems, visited);
@@ -522,8 +648,8 @@ FSDevice::collect(Block nr, std::vector<Block> &result, bool recursive)
     // Move the collected items to the result list
     while (remainingItems.size() > 0) {
         
-        Block item = remainingItems.top();
-        remainingItems.pop();
+        Block item = remainingItems.back();
+        remainingItems.pop_back();
         result.push_back(item);
 
         // Add subdirectory items to the queue
@@ -535,7 +661,8 @@ FSDevice::collect(Block nr, std::vector<Block> &result, bool recursive)
 
 void
 FSDevice::collectHashedRefs(Block nr,
-                            std::stack<Block> &result, std::set<Block> &visited)
+                            std::vector<Block> &result,
+                            std::unordered_set<Block> &visited)
 {
     if (FSBlock *b = blockPtr(nr)) {
         
@@ -548,9 +675,10 @@ FSDevice::collectHashedRefs(Block nr,
 
 void
 FSDevice::collectRefsWithSameHashValue(Block nr,
-                                       std::stack<Block> &result, std::set<Block> &visited)
+                                       std::vector<Block> &result,
+                                       std::unordered_set<Block> &visited)
 {
-    std::stack<Block> refs;
+    auto first = result.size();
     
     // Walk down the linked list
     for (FSBlock *b = hashableBlockPtr(nr); b; b = b->getNextHashBlock()) {
@@ -559,27 +687,79 @@ FSDevice::collectRefsWithSameHashValue(Block nr,
         if (visited.find(b->nr) != visited.end()) throw VAError(ERROR_FS_HAS_CYCLES);
 
         visited.insert(b->nr);
-        refs.push(b->nr);
+        result.push_back(b->nr);
     }
   
-    // Push the collected elements onto the result stack
-    while (refs.size() > 0) { result.push(refs.top()); refs.pop(); }
+    // Reverse the collected elements to keep the first one on top of the stack
+    std::reverse(result.begin() + first, result.end());
 }
 
 FSErrorReport
 FSDevice::check(bool strict) const
+{
+    // Utilize all cores for large volumes such as hard drives
+    isize numThreads = numBlocks >= 16384 ? std::thread::hardware_concurrency() : 1;
+    
+    return check(strict, numThreads);
+}
+
+FSErrorReport
+FSDevice::check(bool strict, isize numThreads) const
 {
     FSErrorReport result;
 
     isize total = 0, min = INT_MAX, max = 0;
     
-    // Analyze all partions
+    // Number of errors found in each block
+    std::vector<isize> errors(numBlocks);
+    
+    /* Checks a range of blocks. Computing a checksum temporarily modifies the
+     * checksum field of the block. Hence, the ranges must not overlap and no
+     * other thread must access the blocks while the workers are running.
+     */
+    auto checkBlocks = [&](isize first, isize last) {
+        for (isize i = first; i < last; i++) errors[i] = blocks[i]->check(strict);
+    };
+    
+    // Analyze all partions (before the workers start to touch the blocks)
     for (auto &p : partitions) p->check(strict, result);
 
-    // Analyze all blocks
+    // Split the block range into chunks of equal size
+    numThreads = std::clamp(numThreads, isize(1), std::max(isize(1), isize(numBlocks / 256)));
+    isize chunk = (numBlocks + numThreads - 1) / numThreads;
+    
+    // Joins all workers when leaving the scope, even if an exception is thrown
+    struct Joiner {
+
+        std::vector<std::thread> &threads;
+        ~Joiner() { for (auto &t : threads) if (t.joinable()) t.join(); }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(numThreads);
+    Joiner joiner { workers };
+
+    // Check all chunks but the first one in the background
+    for (isize t = 1; t < numThreads; t++) {
+        
+        isize first = std::min(t * chunk, isize(numBlocks));
+        isize last = std::min(first + chunk, isize(numBlocks));
+
+        try {
+            workers.emplace_back(checkBlocks, first, last);
+        } catch (std::system_error &) {
+            checkBlocks(first, last);
+        }
+    }
+
+    // Check the first chunk in the calling thread
+    checkBlocks(0, std::min(chunk, isize(numBlocks)));
+    for (auto &worker : workers) worker.join();
+    
+    // Collect the results
     for (isize i = 0; i < numBlocks; i++) {
 
-        if (blocks[i]->check(strict) > 0) {
+        if (errors[i] > 0) {
             min = std::min(min, i);
             max = std::max(max, i);
             blocks[i]->corrupted = ++total;
@@ -754,12 +934,15 @@ FSDevice::importVolume(const u8 *src, isize size)
         blocks[i] = newBlock;
     }
     
+    // The directory structure has changed
+    invalidateDirIndex();
+    
     // Print some debug information
     debug(FS_DEBUG, "Success\n");
     // info();
     // dump();
     // util::hexdump(blocks[0]->data, 512);
-    printDirectory(true);
+    if constexpr (FS_DEBUG) printDirectory(true);
 }
 
 bool
@@ -868,6 +1051,7 @@ FSDevice::importDirectory(const fs::directory_entry &dir, bool recursive)
 
                 changeDir(name);
                 importDirectory(entry, recursive);
+                changeDir("..");
             }
         }
 
@@ -14,8 +14,8 @@
 #include "FSBlock.h"
 #include "ADFFile.h"
 #include "HDFFile.h"
-#include <stack>
-#include <set>
+#include <unordered_map>
+#include <unordered_set>
 
 /* This class provides the basic functionality of the Amiga File Systems OFS
  * and FFS. Starting from an empty volume, files can be added or removed,
@@ -53,6 +53,19 @@ protected:
     // The currently selected directory (reference to FSDirBlock)
     Block cd = 0;
     
+    // Directory index (maps normalized item paths to block references)
+    std::unordered_map<string, Block> dirIndex;
+
+    // Indicates if the directory index needs to be rebuilt
+    bool dirIndexIsDirty = true;
+
+    // Indicates if the directory index covers all items of the volume
+    bool dirIndexIsComplete = false;
+
+    // Normalized path of the current directory (cached)
+    string cdPath;
+    Block cdPathRef = 0;
+
     
     //
     // Initializing
@@ -215,11 +228,16 @@ public:
 
     // Seeks an item inside the current directory
     Block seekRef(FSName name);
+    Block seekRefSlow(FSName name);
     Block seekRef(const string &name) { return seekRef(FSName(name)); }
     FSBlock *seek(const string &name) { return blockPtr(seekRef(name)); }
     FSBlock *seekDir(const string &name) { return userDirBlockPtr(seekRef(name)); }
     FSBlock *seekFile(const string &name) { return fileHeaderBlockPtr(seekRef(name)); }
 
+    // Seeks an item by its full path (relative to the root directory)
+    Block seekPathRef(const string &path);
+    FSBlock *seekPath(const string &path) { return blockPtr(seekPathRef(path)); }
+
     // Adds a reference to the current directory
     void addHashRef(Block nr);
     void addHashRef(FSBlock *block);
@@ -246,6 +264,31 @@ public:
     FSBlock *lastHashBlockInChain(FSBlock *block);
 
     
+    //
+    // Managing the directory index
+    //
+
+public:
+    
+    // Marks the directory index as outdated
+    void invalidateDirIndex() { dirIndexIsDirty = true; }
+
+private:
+    
+    // Rebuilds the directory index by traversing the whole directory tree
+    void buildDirIndex();
+
+    // Adds a newly created item to the directory index
+    void addToDirIndex(FSBlock *block);
+
+    // Returns the normalized index key for a path or a path component
+    static string indexKey(const string &path);
+    static string indexKey(const string &dirKey, FSName name);
+
+    // Returns the normalized path of the current directory
+    const string &currentDirKey();
+
+    
     //
     // Traversing the file system
     //
@@ -258,12 +301,12 @@ public:
 private:
     
     // Collects all references stored in a hash table
-    void collectHashedRefs(Block nr, std::stack<Block> &list,
-                           std::set<Block> &visited) throws;
+    void collectHashedRefs(Block nr, std::vector<Block> &list,
+                           std::unordered_set<Block> &visited) throws;
     
     // Collects all references with the same hash value
-    void collectRefsWithSameHashValue(Block nr, std::stack<Block> &list,
-                                      std::set<Block> &visited) throws;
+    void collectRefsWithSameHashValue(Block nr, std::vector<Block> &list,
+                                      std::unordered_set<Block> &visited) throws;
 
  
     //
@@ -275,6 +318,9 @@ public:
     // Checks all blocks in this volume
     FSErrorReport check(bool strict) const;
 
+    // Checks all blocks in this volume by splitting the work across threads
+    FSErrorReport check(bool strict, isize numThreads) const;
+
     // Checks a single byte in a certain block
     ErrorCode check(Block nr, isize pos, u8 *expected, bool strict) const;
 
@@ -59,6 +59,13 @@ SerialPort::setConfigItem(Option option, i64 value)
                 throw VAError(ERROR_OPT_INVARG, SerialPortDeviceEnum::keyList());
             }
             
+            // Connect or disconnect the pseudo terminal
+            if (value == SPD_PTY) {
+                remoteManager.serServer.openPty();
+            } else {
+                remoteManager.serServer.closePty();
+            }
+
             config.device = (SerialPortDevice)value;            
             return;
                         
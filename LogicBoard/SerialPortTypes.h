@@ -20,7 +20,8 @@ enum_long(SPD)
 {
     SPD_NONE,
     SPD_NULLMODEM,
-    SPD_LOOPBACK
+    SPD_LOOPBACK,
+    SPD_PTY
 };
 typedef SPD SerialPortDevice;
 
@@ -28,7 +29,7 @@ typedef SPD SerialPortDevice;
 struct SerialPortDeviceEnum : util::Reflection<SerialPortDeviceEnum, SerialPortDevice>
 {
     static long minVal() { return 0; }
-    static long maxVal() { return SPD_LOOPBACK; }
+    static long maxVal() { return SPD_PTY; }
     static bool isValid(auto val) { return val >= minVal() && val <= maxVal(); }
     
     static const char *prefix() { return "SPD"; }
@@ -39,6 +40,7 @@ struct SerialPortDeviceEnum : util::Reflection<SerialPortDeviceEnum, SerialPortD
             case SPD_NONE:      return "NONE";
             case SPD_NULLMODEM: return "NULLMODEM";
             case SPD_LOOPBACK:  return "LOOPBACK";
+            case SPD_PTY:       return "PTY";
         }
         return "???";
     }
@@ -294,13 +294,19 @@ void
 ADFFile::encodeTrack(Disk &disk, Track t) const
 {
     isize sectors = numSectors();
+    encodeTrack(disk, t, data + t * sectors * 512, sectors);
+}
+
+void
+ADFFile::encodeTrack(Disk &disk, Track t, const u8 *src, isize sectors)
+{
     debug(ADF_DEBUG, "Encoding Amiga track %ld with %ld sectors\n", t, sectors);
 
     // Format track
     disk.clearTrack(t, 0xAA);
 
     // Encode all sectors
-    for (Sector s = 0; s < sectors; s++) encodeSector(disk, t, s);
+    for (Sector s = 0; s < sectors; s++) encodeSector(disk, t, s, src + s * 512);
     
     // Rectify the first clock bit (where buffer wraps over)
     if (disk.data.track[t][disk.length.track[t] - 1] & 1) {
@@ -313,7 +319,7 @@ ADFFile::encodeTrack(Disk &disk, Track t) const
 }
 
 void
-ADFFile::encodeSector(Disk &disk, Track t, Sector s) const
+ADFFile::encodeSector(Disk &disk, Track t, Sector s, const u8 *src)
 {
     assert(t < disk.numTracks());
     
@@ -354,9 +360,7 @@ ADFFile::encodeSector(Disk &disk, Track t, Sector s) const
     p[i] = 0xAA;
     
     // Data
-    u8 bytes[512];
-    readSector(bytes, t, s);
-    Disk::encodeOddEven(&p[64], bytes, sizeof(bytes));
+    Disk::encodeOddEven(&p[64], src, 512);
     
     // Block checksum
     u8 bcheck[4] = { 0, 0, 0, 0 };
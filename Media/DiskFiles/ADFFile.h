@@ -89,16 +89,20 @@ public:
     isize numSectors() const override;
     BootBlockType bootBlockType() const override;
     const char *bootBlockName() const override;
+    const ADFFile *getADF() const override { return this; }
     
     void killVirus() override;
 
     void encodeDisk(class Disk &disk) const throws override;
     void decodeDisk(class Disk &disk) throws override;
 
+    // Encodes a single track from a buffer of raw sector data
+    static void encodeTrack(class Disk &disk, Track t, const u8 *src, isize sectors);
+
 private:
     
     void encodeTrack(class Disk &disk, Track t) const throws;
-    void encodeSector(class Disk &disk, Track t, Sector s) const throws;
+    static void encodeSector(class Disk &disk, Track t, Sector s, const u8 *src);
 
     void decodeTrack(class Disk &disk, Track t) throws;
     void decodeSector(u8 *dst, u8 *src) throws;
@@ -10,12 +10,19 @@
 #include "config.h"
 #include "DMSFile.h"
 #include "AmigaFile.h"
+#include "Disk.h"
+#include <mutex>
 
 extern "C" {
-unsigned short extractDMS(const unsigned char *in, size_t inSize,
-                          unsigned char **out, size_t *outSize, int verbose);
+typedef int (*DMSTrackHandler)(void *context, unsigned short number,
+                               const unsigned char *data, size_t size);
+unsigned short streamDMS(const unsigned char *in, size_t inSize,
+                         DMSTrackHandler handler, void *context, int verbose);
 }
 
+// The xdms decoder keeps its state in global variables
+static std::mutex xdmsMutex;
+
 DMSFile::~DMSFile()
 {
     if (adf) delete adf;
@@ -35,21 +42,87 @@ DMSFile::isCompatible(std::istream &stream)
 }
 
 void
-DMSFile::finalizeRead()
+DMSFile::decode(const u8 *buf, isize len, const CylinderHandler &handler)
 {
-    assert(adf == nullptr);
-    
-    u8* adfData;
-    size_t adfSize;
-    
-    if (extractDMS(data, (size_t)size, &adfData, &adfSize, DMS_DEBUG) == 0) {
+    struct Context {
+
+        const CylinderHandler &handler;
+        std::exception_ptr exception;
+    };
+
+    // Exceptions must not be thrown through the C code of the decoder
+    auto callback = [](void *context, u16 nr, const u8 *data, size_t size) {
+
+        auto ctx = (Context *)context;
+
+        try {
+
+            ctx->handler(Cylinder(nr), data, isize(size));
+            return 0;
 
-        if constexpr (!FORCE_DMS_CANT_CREATE) {
-            adf = new ADFFile(adfData, (isize)adfSize);
+        } catch (...) {
+
+            ctx->exception = std::current_exception();
+            return 1;
         }
+    };
+
+    Context context { handler, nullptr };
+    u16 error;
+
+    // The decoder reuses its work buffers and runs on a single thread only
+    {   std::lock_guard<std::mutex> lock(xdmsMutex);
+        error = streamDMS(buf, (size_t)len, callback, &context, DMS_DEBUG);
     }
+
+    if (context.exception) std::rethrow_exception(context.exception);
+    if (error || FORCE_DMS_CANT_CREATE) throw VAError(ERROR_DMS_CANT_CREATE);
+}
+
+DiskDensity
+DMSFile::density(const u8 *buf, isize len)
+{
+    if (len < 12 || !util::matchingBufferHeader(buf, (const u8 *)"DMS!", 4)) {
+        throw VAError(ERROR_DMS_CANT_CREATE);
+    }
+
+    // Bit 4 of the info field is set for high density disks
+    return (buf[11] & 0x10) ? DISK_HD : DISK_DD;
+}
+
+void
+DMSFile::encodeDisk(const u8 *buf, isize len, Disk &disk)
+{
+    if (disk.getDiameter() != INCH_35) throw VAError(ERROR_DISK_INVALID_DIAMETER);
+
+    isize sectors = disk.getDensity() == DISK_HD ? 22 : 11;
+
+    // Start with an unformatted disk
+    disk.clearDisk();
+
+    // Encode each cylinder as soon as it has been unpacked
+    decode(buf, len, [&](Cylinder c, const u8 *src, isize count) {
+
+        if (count != 2 * sectors * 512) throw VAError(ERROR_DISK_INVALID_DENSITY);
+        if (c >= disk.numCyls()) return;
+
+        ADFFile::encodeTrack(disk, 2 * c, src, sectors);
+        ADFFile::encodeTrack(disk, 2 * c + 1, src + sectors * 512, sectors);
+    });
+}
+
+void
+DMSFile::finalizeRead()
+{
+    assert(adf == nullptr);
     
-    free(adfData);
-    
-    if (!adf) throw VAError(ERROR_DMS_CANT_CREATE);
+    std::vector<u8> buffer;
+    buffer.reserve(ADFFile::ADFSIZE_35_DD);
+
+    // Collect all cylinders in the order they appear in the archive
+    decode(data, size, [&](Cylinder c, const u8 *src, isize count) {
+        buffer.insert(buffer.end(), src, src + count);
+    });
+
+    adf = new ADFFile(buffer.data(), (isize)buffer.size());
 }
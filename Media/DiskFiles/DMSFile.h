@@ -10,17 +10,40 @@
 #pragma once
 
 #include "ADFFile.h"
+#include <functional>
 
 class DMSFile : public DiskFile {
         
 public:
 
+    // Callback receiving the sector data of a single cylinder
+    typedef std::function<void(Cylinder c, const u8 *data, isize size)> CylinderHandler;
+
     ADFFile *adf = nullptr;
         
     static bool isCompatible(const string &path);
     static bool isCompatible(std::istream &stream);
     
     
+    //
+    // Decompressing
+    //
+    
+public:
+    
+    /* Decompresses an archive cylinder by cylinder. The handler is called
+     * as soon as a cylinder has been unpacked. Hence, no buffer holding the
+     * entire disk is needed.
+     */
+    static void decode(const u8 *buf, isize len, const CylinderHandler &handler) throws;
+
+    // Returns the density of the disk stored in an archive
+    static DiskDensity density(const u8 *buf, isize len) throws;
+
+    // Decompresses an archive directly into an MFM encoded disk
+    static void encodeDisk(const u8 *buf, isize len, class Disk &disk) throws;
+    
+    
     //
     // Initializing
     //
@@ -59,6 +82,7 @@ public:
     isize numSectors() const override { return adf->numSectors(); }
     BootBlockType bootBlockType() const override { return adf->bootBlockType(); }
     const char *bootBlockName() const override { return adf->bootBlockName(); }
+    const ADFFile *getADF() const override { return adf; }
     void readSector(u8 *target, isize s) const override { return adf->readSector(target, s); }
     void readSector(u8 *target, isize t, isize s) const override { return adf->readSector(target, t, s); }
     void encodeDisk(class Disk &disk) const throws override { return adf->encodeDisk(disk); }
@@ -0,0 +1,250 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "DiskConverter.h"
+#include "ADFFile.h"
+#include "Disk.h"
+#include "DMSFile.h"
+#include "Error.h"
+#include "EXTFile.h"
+#include "FSDevice.h"
+#include "IMGFile.h"
+#include "IOUtils.h"
+#include "StringUtils.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <thread>
+
+bool
+DiskConverter::isSupportedFormat(FileType format)
+{
+    switch (format) {
+
+        case FILETYPE_ADF:
+        case FILETYPE_EXT:
+        case FILETYPE_IMG:
+        case FILETYPE_DIR:  return true;
+
+        default:            return false;
+    }
+}
+
+string
+DiskConverter::suffix(FileType format)
+{
+    switch (format) {
+
+        case FILETYPE_ADF:  return ".adf";
+        case FILETYPE_EXT:  return ".ext";
+        case FILETYPE_IMG:  return ".img";
+
+        default:            return "";
+    }
+}
+
+DiskFile *
+DiskConverter::convert(const DiskFile &file, FileType format)
+{
+    switch (format) {
+
+        case FILETYPE_ADF:
+
+            // Copy the sector data if the source provides it
+            if (auto adf = file.getADF()) return new ADFFile(adf->data, adf->size);
+
+            // Otherwise, decode the MFM stream
+            return new ADFFile(*std::make_unique<Disk>(file));
+
+        case FILETYPE_IMG:
+
+            // Copy the sector data if the source provides it
+            if (file.type() == FILETYPE_IMG) return new IMGFile(file.data, file.size);
+
+            // Otherwise, decode the MFM stream
+            return new IMGFile(*std::make_unique<Disk>(file));
+
+        case FILETYPE_EXT:
+
+            // Copy the MFM stream if the source provides it
+            if (file.type() == FILETYPE_EXT) return new EXTFile(file.data, file.size);
+
+            // Otherwise, encode the sector data
+            return new EXTFile(*std::make_unique<Disk>(file));
+
+        default:
+
+            throw VAError(ERROR_FILE_TYPE_UNSUPPORTED);
+    }
+}
+
+void
+DiskConverter::convert(const DiskFile &file, const string &target, FileType format)
+{
+    if (format == FILETYPE_DIR) {
+
+        // Export the file system to a (new or empty) directory
+        std::unique_ptr<ADFFile> adf((ADFFile *)convert(file, FILETYPE_ADF));
+        FSDevice volume(*adf);
+
+        if (!util::isDirectory(target) && !util::createDirectory(target)) {
+            throw VAError(ERROR_FILE_CANT_CREATE, target);
+        }
+        volume.exportDirectory(target);
+        return;
+    }
+
+    std::ofstream stream(target, std::ofstream::binary);
+    if (!stream.is_open()) throw VAError(ERROR_FILE_CANT_WRITE, target);
+
+    if (file.type() == format) {
+
+        // Write the file as is
+        stream.write((const char *)file.data, file.size);
+
+    } else {
+
+        // Convert the file and write the result
+        std::unique_ptr<DiskFile> result(convert(file, format));
+        result->writeToStream(stream);
+    }
+
+    if (!stream.good()) throw VAError(ERROR_FILE_CANT_WRITE, target);
+}
+
+void
+DiskConverter::convert(const string &source, const string &target, FileType format)
+{
+    if (!isSupportedFormat(format)) throw VAError(ERROR_FILE_TYPE_UNSUPPORTED);
+
+    // Stream DMS archives directly into an MFM encoded disk
+    if (format == FILETYPE_EXT && AmigaFile::type(source) == FILETYPE_DMS) {
+
+        u8 *buf; isize len;
+        if (!util::loadFile(source, &buf, &len)) throw VAError(ERROR_FILE_CANT_READ, source);
+        std::unique_ptr<u8[]> archive(buf);
+
+        auto disk = std::make_unique<Disk>(INCH_35, DMSFile::density(buf, len));
+        DMSFile::encodeDisk(buf, len, *disk);
+        convert(EXTFile(*disk), target, format);
+        return;
+    }
+
+    std::unique_ptr<DiskFile> file(DiskFile::make(source));
+    convert(*file, target, format);
+}
+
+std::vector<DiskConverter::Job>
+DiskConverter::makeJobs(const string &sourceDir, const string &targetDir, FileType format)
+{
+    std::vector<Job> result;
+    std::vector<fs::path> entries;
+
+    // Names of all target files (lowercased for case-insensitive file systems)
+    std::set<string> targets;
+
+    try {
+
+        // Process the files in a deterministic order
+        for (const auto &entry : fs::directory_iterator(sourceDir)) {
+            entries.push_back(entry.path());
+        }
+        std::sort(entries.begin(), entries.end());
+
+        for (const auto &entry : entries) {
+
+            const auto path = entry.string();
+            const auto name = entry.filename().string();
+
+            // Skip all hidden files and the target directory
+            if (name[0] == '.') continue;
+            if (fs::exists(targetDir) && fs::equivalent(entry, targetDir)) continue;
+
+            switch (AmigaFile::type(path)) {
+
+                case FILETYPE_ADF:
+                case FILETYPE_EXT:
+                case FILETYPE_IMG:
+                case FILETYPE_DMS:
+                case FILETYPE_EXE:
+                case FILETYPE_DIR:
+                {
+                    auto base = util::stripSuffix(name);
+                    auto target = base + suffix(format);
+
+                    /* Sources which only differ in their suffix (e.g., foo.adf
+                     * and foo.dms) must not be written to the same file. The
+                     * target name is disambiguated by a number in this case.
+                     */
+                    for (isize i = 2; !targets.insert(util::lowercased(target)).second; i++) {
+                        target = base + "_" + std::to_string(i) + suffix(format);
+                    }
+
+                    result.push_back(Job {
+                        path, util::appendPath(targetDir, target), format });
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+    } catch (fs::filesystem_error &) {
+
+        throw VAError(ERROR_FILE_CANT_READ, sourceDir);
+    }
+
+    return result;
+}
+
+isize
+DiskConverter::convert(std::vector<Job> &jobs, isize numThreads)
+{
+    if (jobs.empty()) return 0;
+    
+    std::atomic<isize> next = 0, failed = 0;
+
+    auto worker = [&]() {
+
+        for (isize i = next++; i < (isize)jobs.size(); i = next++) {
+
+            auto &job = jobs[i];
+
+            try {
+
+                convert(job.source, job.target, job.format);
+                job.error = ERROR_OK;
+
+            } catch (VAError &err) {
+
+                job.error = ErrorCode(err.data);
+                failed++;
+
+            } catch (...) {
+
+                job.error = ERROR_UNKNOWN;
+                failed++;
+            }
+        }
+    };
+
+    if (numThreads <= 0) numThreads = std::thread::hardware_concurrency();
+    numThreads = std::clamp(numThreads, isize(1), isize(jobs.size()));
+
+    // Launch the workers and participate in the work
+    std::vector<std::thread> workers;
+    for (isize i = 1; i < numThreads; i++) workers.push_back(std::thread(worker));
+    worker();
+    for (auto &w : workers) w.join();
+
+    return failed;
+}
@@ -0,0 +1,86 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "DiskFile.h"
+#include "ErrorTypes.h"
+#include <vector>
+
+/* This class converts disk files from one format into another. Supported
+ * source formats are ADF, EXT, IMG, DMS, EXE, and folders. Supported target
+ * formats are ADF, EXT, IMG, and folders.
+ *
+ * Whenever possible, the sector data is copied directly from the source file
+ * to the target file. An MFM encoded Disk is only created as an intermediate
+ * step if one of both formats stores raw MFM data, i.e., if an EXT file is
+ * created or if an EXT file without a standard AmigaDOS layout is converted.
+ * DMS archives are encoded while being unpacked, without creating an
+ * intermediate ADF.
+ *
+ * Batches of files are processed concurrently by a pool of worker threads.
+ */
+
+class DiskConverter {
+
+public:
+
+    // A single conversion task
+    struct Job {
+
+        // Path to the source file or directory
+        string source;
+
+        // Path to the target file or directory
+        string target;
+
+        // Format of the target file
+        FileType format = FILETYPE_ADF;
+
+        // Outcome of the conversion
+        ErrorCode error = ERROR_OK;
+    };
+
+
+    //
+    // Converting single files
+    //
+
+public:
+
+    // Checks if files can be converted to the specified format
+    static bool isSupportedFormat(FileType format);
+
+    // Returns the file name suffix for a target format
+    static string suffix(FileType format);
+
+    // Converts a disk file into a disk file of another type
+    static DiskFile *convert(const DiskFile &file, FileType format) throws;
+
+    // Converts a disk file and writes the result to the file system
+    static void convert(const DiskFile &file, const string &target, FileType format) throws;
+    static void convert(const string &source, const string &target, FileType format) throws;
+
+
+    //
+    // Converting batches
+    //
+
+public:
+
+    /* Creates a job list for all disk files inside a directory. Each job is
+     * assigned a unique target file.
+     */
+    static std::vector<Job> makeJobs(const string &sourceDir,
+                                     const string &targetDir,
+                                     FileType format);
+
+    // Processes a list of jobs and returns the number of failed conversions
+    static isize convert(std::vector<Job> &jobs, isize numThreads = 0);
+};
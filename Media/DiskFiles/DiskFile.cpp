@@ -10,6 +10,7 @@
 #include "config.h"
 #include "DiskFile.h"
 #include "ADFFile.h"
+#include "EXTFile.h"
 #include "IMGFile.h"
 #include "DMSFile.h"
 #include "EXEFile.h"
@@ -24,6 +25,7 @@ DiskFile::make(const string &path)
     switch (type(path)) {
             
         case FILETYPE_ADF:  return new ADFFile(path, stream);
+        case FILETYPE_EXT:  return new EXTFile(path);
         case FILETYPE_IMG:  return new IMGFile(path, stream);
         case FILETYPE_DMS:  return new DMSFile(path, stream);
         case FILETYPE_EXE:  return new EXEFile(path, stream);
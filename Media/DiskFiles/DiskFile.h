@@ -61,6 +61,13 @@ public:
     bool hasVirus() const { return bootBlockType() == BB_VIRUS; }
 
     
+    // Returns the sector data of this disk in ADF format (if available)
+    virtual const class ADFFile *getADF() const { return nullptr; }
+
+    // Returns the ADF the MFM encoder works on (if the disk is encoded from it)
+    virtual const class ADFFile *getEncoderADF() const { return getADF(); }
+    
+    
     //
     // Reading data
     //
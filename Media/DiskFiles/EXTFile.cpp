@@ -190,18 +190,13 @@ EXTFile::encodeDisk(class Disk &disk) const
 void
 EXTFile::encodeTrack(class Disk &disk, Track t) const
 {
-    auto numTracks = storedTracks();
+    debug(MFM_DEBUG, "Encoding track %ld\n", t);
     
-    for (isize i = 0; i < numTracks; i++) {
-
-        debug(MFM_DEBUG, "Encoding track %ld\n", i);
-        
-        auto numBits = usedBitsForTrack(i);
-        assert(numBits % 8 == 0);
-        
-        std::memcpy(disk.data.track[i], trackData(i), numBits / 8);
-        disk.length.track[i] = (i32)(numBits / 8);
-    }
+    auto numBits = usedBitsForTrack(t);
+    assert(numBits % 8 == 0);
+    
+    std::memcpy(disk.data.track[t], trackData(t), numBits / 8);
+    disk.length.track[t] = (i32)(numBits / 8);
 }
 
 void
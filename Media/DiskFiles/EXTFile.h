@@ -99,6 +99,8 @@ public:
     isize numCyls() const override;
     isize numTracks() const override; 
     isize numSectors() const override;
+    const ADFFile *getADF() const override { return adf; }
+    const ADFFile *getEncoderADF() const override { return nullptr; }
     
     u8 readByte(isize b, isize offset) const override { return 0; }
     u8 readByte(isize t, isize s, isize offset) const override { return 0; }
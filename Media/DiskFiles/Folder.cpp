@@ -32,9 +32,11 @@ Folder::init(const string &path)
     // Make the volume bootable
     volume.makeBootable(BB_AMIGADOS_13);
     
-    // Check the file system for errors
-    volume.info();
-    volume.printDirectory(true);
+    // Print some debug information about the volume
+    if constexpr (FS_DEBUG) {
+        volume.info();
+        volume.printDirectory(true);
+    }
 
     // Check the file system for consistency
     FSErrorReport report = volume.check(true);
@@ -0,0 +1,134 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "ImageCache.h"
+#include "ADFFile.h"
+#include "Checksum.h"
+#include "Disk.h"
+#include "DiskFile.h"
+#include <cstring>
+
+std::mutex ImageCache::mutex;
+std::unordered_map<u32, std::weak_ptr<const RomImage>> ImageCache::roms;
+std::unordered_map<u64, std::weak_ptr<Disk>> ImageCache::disks;
+
+std::shared_ptr<const RomImage>
+ImageCache::rom(const u8 *buf, isize len)
+{
+    assert(buf != nullptr || len == 0);
+
+    auto crc = util::crc32(buf, len);
+
+    if constexpr (!NO_IMAGE_CACHE) {
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (auto it = roms.find(crc); it != roms.end()) {
+
+            // Reuse the cached image if the contents match
+            if (auto image = it->second.lock()) {
+                if (image->size == len && std::memcmp(image->data.get(), buf, len) == 0) {
+                    return image;
+                }
+            }
+        }
+    }
+
+    // Create a new image
+    auto image = std::make_shared<RomImage>();
+    image->data = std::make_unique<u8[]>(len);
+    image->size = len;
+    image->crc = crc;
+    std::memcpy(image->data.get(), buf, len);
+
+    if constexpr (!NO_IMAGE_CACHE) {
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Register the image unless the slot is occupied by a live image
+        if (roms[crc].expired()) roms[crc] = image;
+        purge();
+    }
+
+    return image;
+}
+
+std::shared_ptr<Disk>
+ImageCache::disk(const DiskFile &file)
+{
+    auto key = diskKey(file);
+
+    if constexpr (!NO_IMAGE_CACHE) {
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (auto it = disks.find(key); it != disks.end()) {
+            if (auto disk = it->second.lock()) return disk;
+        }
+    }
+
+    // Encode the disk (outside the critical section, as this takes a while)
+    auto disk = std::make_shared<Disk>(file);
+
+    if constexpr (!NO_IMAGE_CACHE) {
+
+        // Prepare the disk for decoding, as shared disks must not be altered
+        disk->repeatTracks();
+
+        std::lock_guard<std::mutex> lock(mutex);
+
+        // Another thread might have encoded the same disk in the meantime
+        if (auto existing = disks[key].lock()) return existing;
+
+        disk->shared = true;
+        disks[key] = disk;
+        purge();
+    }
+
+    return disk;
+}
+
+isize
+ImageCache::numRoms()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    purge();
+    return (isize)roms.size();
+}
+
+isize
+ImageCache::numDisks()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    purge();
+    return (isize)disks.size();
+}
+
+u64
+ImageCache::diskKey(const DiskFile &file)
+{
+    /* Files encoded via an ADF (DMS, EXE, folders) share the cache entry with
+     * the ADF itself. All other files (e.g., EXT files, which are encoded from
+     * raw MFM data) are keyed by their own contents.
+     */
+    if (auto adf = file.getEncoderADF()) {
+        return util::fnv_1a_it64(adf->fnv(), FILETYPE_ADF);
+    }
+    return util::fnv_1a_it64(file.fnv(), file.type());
+}
+
+void
+ImageCache::purge()
+{
+    std::erase_if(roms, [](const auto &it) { return it.second.expired(); });
+    std::erase_if(disks, [](const auto &it) { return it.second.expired(); });
+}
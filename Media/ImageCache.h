@@ -0,0 +1,81 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "Types.h"
+#include "Exception.h"
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+class Disk;
+class DiskFile;
+
+// A read-only Rom image
+struct RomImage {
+
+    // The Rom data
+    std::unique_ptr<u8[]> data;
+
+    // Size of the Rom data in bytes
+    isize size = 0;
+
+    // CRC-32 checksum of the Rom data
+    u32 crc = 0;
+};
+
+/* This class implements a process-wide, content-addressed cache for Rom images
+ * and MFM encoded disks. If multiple Amiga instances run side by side, they
+ * usually use the same Kickstart and the same set of disks. Instead of keeping
+ * a private copy in each instance, all instances share a single read-only
+ * copy which is looked up by fingerprint.
+ *
+ * Cached objects are never modified. Memory never writes into Rom space and
+ * a drive replaces a shared disk by a private copy before it gets written to
+ * (copy-on-write). The cache only keeps weak references. Hence, an image is
+ * released as soon as the last instance stops using it.
+ */
+
+class ImageCache {
+
+    // Guards the cache tables
+    static std::mutex mutex;
+
+    // Cached Rom images, indexed by CRC-32 checksum
+    static std::unordered_map<u32, std::weak_ptr<const RomImage>> roms;
+
+    // Cached disks, indexed by the fingerprint of the source file
+    static std::unordered_map<u64, std::weak_ptr<Disk>> disks;
+
+
+    //
+    // Accessing the cache
+    //
+
+public:
+
+    // Returns a shared Rom image with the provided contents
+    static std::shared_ptr<const RomImage> rom(const u8 *buf, isize len);
+
+    // Returns a shared disk created from the provided disk file
+    static std::shared_ptr<Disk> disk(const DiskFile &file) throws;
+
+    // Returns the number of images that are currently in use
+    static isize numRoms();
+    static isize numDisks();
+
+private:
+
+    // Computes the lookup key for a disk file
+    static u64 diskKey(const DiskFile &file);
+
+    // Removes all expired entries
+    static void purge();
+};
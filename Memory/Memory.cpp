@@ -16,6 +16,7 @@
 #include "CPU.h"
 #include "Denise.h"
 #include "ExtendedRomFile.h"
+#include "ImageCache.h"
 #include "MsgQueue.h"
 #include "Paula.h"
 #include "RomFile.h"
@@ -30,6 +31,10 @@ Memory::~Memory()
 void
 Memory::dealloc()
 {
+    // Shared Rom images are released by the image cache
+    if (romImage) { romImage = nullptr; rom = nullptr; }
+    if (extImage) { extImage = nullptr; ext = nullptr; }
+
     if (rom) { delete[] rom; rom = nullptr; }
     if (wom) { delete[] wom; wom = nullptr; }
     if (ext) { delete[] ext; ext = nullptr; }
@@ -526,6 +531,9 @@ Memory::allocFast(i32 bytes, bool update)
 void
 Memory::allocRom(i32 bytes, bool update)
 {
+    // Detach from a shared Rom image without freeing it
+    if (romImage) { romImage = nullptr; rom = nullptr; config.romSize = 0; romMask = 0; }
+
     alloc(bytes, rom, config.romSize, romMask, update);
 }
 
@@ -538,9 +546,42 @@ Memory::allocWom(i32 bytes, bool update)
 void
 Memory::allocExt(i32 bytes, bool update)
 {
+    // Detach from a shared Rom image without freeing it
+    if (extImage) { extImage = nullptr; ext = nullptr; config.extSize = 0; extMask = 0; }
+
     alloc(bytes, ext, config.extSize, extMask, update);
 }
 
+void
+Memory::shareRom(std::shared_ptr<const RomImage> image)
+{
+    assert(image != nullptr);
+
+    allocRom(0, false);
+
+    romImage = image;
+    rom = image->data.get();
+    config.romSize = (i32)image->size;
+    romMask = config.romSize - 1;
+
+    updateMemSrcTables();
+}
+
+void
+Memory::shareExt(std::shared_ptr<const RomImage> image)
+{
+    assert(image != nullptr);
+
+    allocExt(0, false);
+
+    extImage = image;
+    ext = image->data.get();
+    config.extSize = (i32)image->size;
+    extMask = config.extSize - 1;
+
+    updateMemSrcTables();
+}
+
 void
 Memory::fillRamWithInitPattern()
 {
@@ -578,13 +619,13 @@ Memory::fillRamWithInitPattern()
 u32
 Memory::romFingerprint() const
 {
-    return util::crc32(rom, config.romSize);
+    return romImage ? romImage->crc : util::crc32(rom, config.romSize);
 }
 
 u32
 Memory::extFingerprint() const
 {
-    return util::crc32(ext, config.extSize);
+    return extImage ? extImage->crc : util::crc32(ext, config.extSize);
 }
 
 RomIdentifier
@@ -661,6 +702,24 @@ Memory::extModel()
     return RomFile::model(extIdentifier());
 }
 
+void
+Memory::eraseRom()
+{
+    // Replace a shared Rom by a private one
+    if (romImage) allocRom(config.romSize);
+
+    std::memset(rom, 0, config.romSize);
+}
+
+void
+Memory::eraseExt()
+{
+    // Replace a shared Rom by a private one
+    if (extImage) allocExt(config.extSize);
+
+    std::memset(ext, 0, config.extSize);
+}
+
 bool
 Memory::hasArosRom() const
 {
@@ -675,11 +734,8 @@ Memory::loadRom(RomFile &file)
     // Decrypt Rom
     file.decrypt();
 
-    // Allocate memory
-    allocRom((i32)file.size);
-
-    // Load Rom
-    file.flash(rom);
+    // Install the Rom (shared with all other instances using the same Rom)
+    shareRom(ImageCache::rom(file.data, file.size));
 
     // Add a Wom if a Boot Rom is installed instead of a Kickstart Rom
     hasBootRom() ? (void)allocWom(KB(256)) : deleteWom();
@@ -705,11 +761,8 @@ Memory::loadRom(const u8 *buf, isize len)
 void
 Memory::loadExt(ExtendedRomFile &file)
 {
-    // Allocate memory
-    allocExt((i32)file.size);
-    
-    // Load Rom
-    file.flash(ext);
+    // Install the Rom (shared with all other instances using the same Rom)
+    shareExt(ImageCache::rom(file.data, file.size));
 }
 
 void
@@ -1386,6 +1439,108 @@ Memory::spypeek32 <ACCESSOR_CPU> (u32 addr) const
     return HI_W_LO_W(hi, lo);
 }
 
+u8 *
+Memory::hostAddr(u32 addr, isize count) const
+{
+    auto contiguous = [&](u32 mask) { return (mask & 0xFFFF) == 0xFFFF; };
+
+    switch (cpuMemSrc[addr >> 16]) {
+
+        case MEM_CHIP:
+        case MEM_CHIP_MIRROR:
+
+            return contiguous(chipMask) ? chip + (addr & chipMask) : nullptr;
+
+        case MEM_SLOW:
+        case MEM_SLOW_MIRROR:
+
+            return contiguous(slowMask) ? slow + (addr & slowMask) : nullptr;
+
+        case MEM_FAST:
+
+            if (addr - FAST_RAM_STRT + count > (u32)config.fastSize) return nullptr;
+            return fast + (addr - FAST_RAM_STRT);
+
+        case MEM_ROM:
+        case MEM_ROM_MIRROR:
+
+            return contiguous(romMask) ? rom + (addr & romMask) : nullptr;
+
+        case MEM_WOM:
+
+            return contiguous(womMask) ? wom + (addr & womMask) : nullptr;
+
+        case MEM_EXT:
+
+            return contiguous(extMask) ? ext + (addr & extMask) : nullptr;
+
+        default:
+
+            return nullptr;
+    }
+}
+
+void
+Memory::spypeek(u32 addr, isize count, u8 *buffer) const
+{
+    while (count > 0) {
+
+        // Process the data bank by bank
+        addr &= 0xFFFFFF;
+        auto chunk = std::min(count, isize(0x10000 - (addr & 0xFFFF)));
+
+        if (auto src = hostAddr(addr, chunk)) {
+
+            // Copy RAM and ROM contents in one go
+            std::memcpy(buffer, src, chunk);
+
+        } else {
+
+            // Read I/O registers and unmapped areas byte by byte
+            for (isize i = 0; i < chunk; i++) {
+                buffer[i] = spypeek8 <ACCESSOR_CPU> (u32(addr + i));
+            }
+        }
+
+        addr += (u32)chunk;
+        buffer += chunk;
+        count -= chunk;
+    }
+}
+
+bool
+Memory::patch(u32 addr, isize count, const u8 *buffer)
+{
+    bool success = true;
+
+    while (count > 0) {
+
+        addr &= 0xFFFFFF;
+        auto chunk = std::min(count, isize(0x10000 - (addr & 0xFFFF)));
+        auto src = cpuMemSrc[addr >> 16];
+
+        // Roms shared with other instances must not be modified
+        bool shared =
+        ((src == MEM_ROM || src == MEM_ROM_MIRROR) && romImage) ||
+        (src == MEM_EXT && extImage);
+
+        if (auto dst = shared ? nullptr : hostAddr(addr, chunk)) {
+            std::memcpy(dst, buffer, chunk);
+        } else {
+            success = false;
+        }
+
+        addr += (u32)chunk;
+        buffer += chunk;
+        count -= chunk;
+    }
+
+    // Decoded OS structures may refer to the modified memory
+    osDebugger.invalidate();
+
+    return success;
+}
+
 
 //
 // Peek (Agnus)
@@ -13,6 +13,9 @@
 #include "SubComponent.h"
 #include "RomFileTypes.h"
 #include "MemUtils.h"
+#include <memory>
+
+struct RomImage;
 
 // DEPRECATED. TODO: GET VALUE FROM ZORRO CARD MANANGER
 const u32 FAST_RAM_STRT = 0x200000;
@@ -169,6 +172,13 @@ public:
     u32 slowMask = 0;
     u32 fastMask = 0;
 
+    /* Rom images shared with other Amiga instances via the image cache. If
+     * set, rom or ext points into the shared image which must neither be
+     * modified nor deleted.
+     */
+    std::shared_ptr<const RomImage> romImage;
+    std::shared_ptr<const RomImage> extImage;
+
     /* Indicates if the Kickstart Wom is writable. If an Amiga 1000 Boot Rom is
      * installed, a Kickstart WOM (Write Once Memory) is added automatically.
      * On startup, the WOM is unlocked which means that it is writable. During
@@ -312,6 +322,10 @@ public:
     void deleteWom() { allocWom(0); }
     void deleteExt() { allocExt(0); }
 
+    // Installs a shared Rom image
+    void shareRom(std::shared_ptr<const RomImage> image);
+    void shareExt(std::shared_ptr<const RomImage> image);
+
 
     //
     // Managing RAM
@@ -341,7 +355,7 @@ private:
 
 public:
 
-    // Computes a CRC-32 checksum
+    // Returns a CRC-32 checksum (precomputed for shared images)
     u32 romFingerprint() const;
     u32 extFingerprint() const;
 
@@ -368,9 +382,9 @@ public:
     bool hasExt() const { return ext != nullptr; }
 
     // Erases an installed Rom
-    void eraseRom() { std::memset(rom, 0, config.romSize); }
+    void eraseRom();
     void eraseWom() { std::memset(wom, 0, config.womSize); }
-    void eraseExt() { std::memset(ext, 0, config.extSize); }
+    void eraseExt();
     
     // Installs a Boot Rom or Kickstart Rom
     void loadRom(class RomFile &rom) throws;
@@ -414,6 +428,12 @@ private:
     void updateCpuMemSrcTable();
     void updateAgnusMemSrcTable();
 
+    /* Returns a pointer to the buffer backing a certain memory address. A
+     * null pointer is returned if the specified range is not mapped to a
+     * contiguous RAM or Rom area. The range must not cross a bank boundary.
+     */
+    u8 *hostAddr(u32 addr, isize count) const;
+
     
     //
     // Accessing memory
@@ -436,6 +456,15 @@ public:
     template <Accessor acc, MemorySource src> void poke16(u32 addr, u16 value);
     template <Accessor acc> void poke8(u32 addr, u8 value);
     template <Accessor acc> void poke16(u32 addr, u16 value);
+
+    // Reads a block of memory as seen by the CPU without causing side effects
+    void spypeek(u32 addr, isize count, u8 *buffer) const;
+
+    /* Writes a block of memory as seen by the CPU. This function is intended
+     * for debuggers. Only RAM and Rom areas are modified. I/O registers and
+     * unmapped areas are left untouched in which case false is returned.
+     */
+    bool patch(u32 addr, isize count, const u8 *buffer);
     
 
     //
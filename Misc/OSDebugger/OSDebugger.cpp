@@ -310,18 +310,16 @@ OSDebugger::searchTask(u32 addr, os::Task &result) const
 bool
 OSDebugger::searchTask(const string &name, os::Task &result) const
 {
-    std::vector <os::Task> tasks;
-    read(tasks);
-    
-    for (usize i = 0; i < tasks.size(); i++) {
+    SYNCHRONIZED
+
+    validateCache();
+    for (auto &info : cachedTaskInfos()) {
         
-        string nodeName;
-        read(tasks[i].tc_Node.ln_Name, nodeName);
-        auto shortName = nodeName.substr(0, nodeName.find("."));
+        auto shortName = info.name.substr(0, info.name.find("."));
         
-        if (name == nodeName || name == shortName) {
+        if (name == info.name || name == shortName) {
             
-            result = tasks[i];
+            result = info.task;
             return true;
         }
     }
@@ -352,38 +350,15 @@ OSDebugger::searchProcess(u32 addr, os::Process &result) const
 bool
 OSDebugger::searchProcess(const string &name, os::Process &result) const
 {
+    SYNCHRONIZED
+
     try {
-        std::vector <os::Process> processes;
-        read(processes);
-        
-        for (usize i = 0; i < processes.size(); i++) {
-            
-            string nodeName;
-            read(processes[i].pr_Task.tc_Node.ln_Name, nodeName);
-            if (!nodeName.empty() && name == nodeName) {
-                result = processes[i];
-                return true;
-            }
-            
-            string shortName = nodeName.substr(0, nodeName.find("."));
-            if (!shortName.empty() && name == shortName) {
-                result = processes[i];
-                return true;
-            }
-            
-            if (processes[i].pr_CLI) {
-                
-                os::CommandLineInterface cli;
-                read(BPTR(processes[i].pr_CLI), &cli);
-                
-                string cmdName;
-                read(BPTR(cli.cli_CommandName) + 1, cmdName);
-                if (!cmdName.empty() && name == cmdName) {
 
-                    result = processes[i];
-                    return true;
-                }
-            }
+        validateCache();
+        if (auto info = findProcess(name)) {
+
+            result = info->process;
+            return true;
         }
     } catch (...) { }
     
@@ -12,11 +12,43 @@
 #include "OSDebuggerTypes.h"
 #include "SubComponent.h"
 #include "Constants.h"
+#include <map>
 
 class OSDebugger : public SubComponent {
     
 private:
     
+    /* Decoded OS structures. Walking the system lists requires many memory
+     * accesses. To speed up repeated queries, the decoded structures are
+     * cached. The cache refers to a single master clock cycle. Hence, it is
+     * discarded whenever the emulator advances, including single steps. It is
+     * also discarded when the emulator is reset, a snapshot is loaded, or
+     * memory is modified by a debugger. The cache is only accessed while the
+     * component mutex is held, because the RetroShell queries it from the GUI
+     * thread while the emulator thread is running.
+     */
+    struct Cache {
+
+        // The cycle the cached data refers to (-1 if the cache is empty)
+        Cycle clock = -1;
+
+        bool hasExecBase = false;
+        os::ExecBase execBase;
+
+        bool hasTasks = false;
+        std::vector <os::Task> tasks;
+
+        bool hasProcesses = false;
+        std::vector <os::Process> processes;
+
+        bool hasTaskInfos = false;
+        std::vector <os::TaskInfo> taskInfos;
+
+        // Segment lists indexed by process address
+        std::map <u32, os::SegList> segLists;
+    };
+    mutable Cache cache;
+    
     //
     // Constructing
     //
@@ -42,7 +74,8 @@ private:
         
 private:
     
-    void _reset(bool hard) override { };
+    void _reset(bool hard) override { invalidate(); }
+    void _didLoad() override { invalidate(); }
     
     
     //
@@ -55,6 +88,35 @@ private:
     isize _save(u8 *buffer) override { return 0; }
     
     
+    //
+    // Caching decoded structures
+    //
+
+public:
+
+    // Discards all cached structures
+    void invalidate() { SYNCHRONIZED cache.clock = -1; }
+
+private:
+
+    // Discards all cached structures if they refer to another cycle
+    void validateCache() const;
+
+    /* Return cached structures and decode them on demand. These functions
+     * must be called with the mutex held and after the cache has been
+     * validated. They never validate the cache themselves, which guarantees
+     * that all data returned by a single query refers to the same cycle.
+     */
+    const os::ExecBase &cachedExecBase() const throws;
+    const std::vector <os::Task> &cachedTasks() const throws;
+    const std::vector <os::Process> &cachedProcesses() const throws;
+    const std::vector <os::TaskInfo> &cachedTaskInfos() const throws;
+    const os::SegList &cachedSegList(const os::Process &pr) const;
+
+    // Searches a process by name in the cached task list
+    const os::TaskInfo *findProcess(const string &name) const throws;
+
+
     //
     // Translating enumeration types to strings
     //
@@ -134,6 +196,9 @@ public:
     void read(const os::Process &pr, os::SegList &result) const;
     void read(u32 addr, os::SegList &result) const;
 
+    // Collects all tasks together with their names and segment lists
+    void read(std::vector <os::TaskInfo> &result) const throws;
+
     
     //
     // Searches a structure by value (address or index), or name
@@ -9,9 +9,11 @@
 
 #include "config.h"
 #include "OSDebugger.h"
+#include "Agnus.h"
 #include "IOUtils.h"
 #include "Memory.h"
 
+
 void
 OSDebugger::read(u32 addr, u8 *result) const
 {
@@ -57,12 +59,10 @@ OSDebugger::read(u32 addr, string &result, isize limit) const
 os::ExecBase
 OSDebugger::getExecBase() const
 {
-    os::ExecBase result;
-    
-    read(mem.spypeek32 <ACCESSOR_CPU> (4), &result);
-    checkExecBase(result);
-    
-    return result;
+    SYNCHRONIZED
+
+    validateCache();
+    return cachedExecBase();
 }
 
 void
@@ -361,31 +361,31 @@ OSDebugger::read(u32 addr, os::ExecBase *result) const
 void
 OSDebugger::read(std::vector <os::Task> &result) const
 {
-    auto execBase = getExecBase();
-        
-    os::Task current;
-    read(execBase.ThisTask, &current);
-    
-    result.push_back(current);
-    read(execBase.TaskReady.lh_Head, result);
-    read(execBase.TaskWait.lh_Head, result);
+    SYNCHRONIZED
+
+    validateCache();
+    auto &tasks = cachedTasks();
+    result.insert(result.end(), tasks.begin(), tasks.end());
 }
 
 void
 OSDebugger::read(std::vector <os::Process> &result) const
 {
-    std::vector <os::Task> tasks;
-    read(tasks);
-    
-    for (auto &t : tasks) {
-        
-        if (t.tc_Node.ln_Type == os::NT_PROCESS) {
-            
-            os::Process process;
-            read(t.addr, &process);
-            result.push_back(process);
-        }
-    }
+    SYNCHRONIZED
+
+    validateCache();
+    auto &processes = cachedProcesses();
+    result.insert(result.end(), processes.begin(), processes.end());
+}
+
+void
+OSDebugger::read(std::vector <os::TaskInfo> &result) const
+{
+    SYNCHRONIZED
+
+    validateCache();
+    auto &infos = cachedTaskInfos();
+    result.insert(result.end(), infos.begin(), infos.end());
 }
 
 void
@@ -417,16 +417,164 @@ OSDebugger::read(u32 addr, std::vector <os::Library> &result) const
 void
 OSDebugger::read(const string &prName, os::SegList &result) const
 {
-    os::Process process;
-    if (searchProcess(prName, process)) {
+    SYNCHRONIZED
+
+    try {
+
+        validateCache();
+        if (auto info = findProcess(prName)) {
+
+            result.insert(result.end(), info->segList.begin(), info->segList.end());
+        }
+    } catch (...) { }
+}
+
+void
+OSDebugger::read(const os::Process &pr, os::SegList &result) const
+{
+    SYNCHRONIZED
+
+    validateCache();
+    auto &segList = cachedSegList(pr);
+    result.insert(result.end(), segList.begin(), segList.end());
+}
+
+void
+OSDebugger::read(u32 addr, os::SegList &result) const
+{
+    for (isize i = 0; isValidPtr(addr) && i < 128; i++) {
+        
+        auto size = mem.spypeek32 <ACCESSOR_CPU> (addr - 4) - 8;
+        auto next = mem.spypeek32 <ACCESSOR_CPU> (addr);
+        auto data = addr + 4;
         
-        read(process, result);
+        result.push_back(std::make_pair(data, size));
+        addr = BPTR(next);
     }
 }
 
+
+//
+// Caching decoded structures
+//
+
 void
-OSDebugger::read(const os::Process &pr, os::SegList &result) const
+OSDebugger::validateCache() const
+{
+    if (cache.clock != agnus.clock) {
+
+        cache = Cache { };
+        cache.clock = agnus.clock;
+    }
+}
+
+const os::ExecBase &
+OSDebugger::cachedExecBase() const
+{
+    if (!cache.hasExecBase) {
+
+        os::ExecBase execBase;
+
+        read(mem.spypeek32 <ACCESSOR_CPU> (4), &execBase);
+        checkExecBase(execBase);
+
+        cache.execBase = execBase;
+        cache.hasExecBase = true;
+    }
+    return cache.execBase;
+}
+
+const std::vector <os::Task> &
+OSDebugger::cachedTasks() const
 {
+    if (!cache.hasTasks) {
+
+        auto &execBase = cachedExecBase();
+        std::vector <os::Task> tasks;
+
+        os::Task current;
+        read(execBase.ThisTask, &current);
+
+        tasks.push_back(current);
+        read(execBase.TaskReady.lh_Head, tasks);
+        read(execBase.TaskWait.lh_Head, tasks);
+
+        cache.tasks = std::move(tasks);
+        cache.hasTasks = true;
+    }
+    return cache.tasks;
+}
+
+const std::vector <os::Process> &
+OSDebugger::cachedProcesses() const
+{
+    if (!cache.hasProcesses) {
+
+        std::vector <os::Process> processes;
+
+        for (auto &t : cachedTasks()) {
+
+            if (t.tc_Node.ln_Type == os::NT_PROCESS) {
+
+                os::Process process;
+                read(t.addr, &process);
+                processes.push_back(process);
+            }
+        }
+
+        cache.processes = std::move(processes);
+        cache.hasProcesses = true;
+    }
+    return cache.processes;
+}
+
+const std::vector <os::TaskInfo> &
+OSDebugger::cachedTaskInfos() const
+{
+    if (!cache.hasTaskInfos) {
+
+        std::vector <os::TaskInfo> infos;
+
+        for (auto &t : cachedTasks()) {
+
+            os::TaskInfo info;
+
+            info.task = t;
+            read(t.tc_Node.ln_Name, info.name);
+
+            if (t.tc_Node.ln_Type == os::NT_PROCESS) {
+
+                info.isProcess = true;
+                read(t.addr, &info.process);
+
+                if (info.process.pr_CLI) {
+
+                    os::CommandLineInterface cli;
+                    read(BPTR(info.process.pr_CLI), &cli);
+                    read(BPTR(cli.cli_CommandName) + 1, info.command);
+                }
+                info.segList = cachedSegList(info.process);
+            }
+
+            infos.push_back(info);
+        }
+
+        cache.taskInfos = std::move(infos);
+        cache.hasTaskInfos = true;
+    }
+    return cache.taskInfos;
+}
+
+const os::SegList &
+OSDebugger::cachedSegList(const os::Process &pr) const
+{
+    // Check if the segment list has been decoded before
+    if (auto it = cache.segLists.find(pr.addr); it != cache.segLists.end()) {
+        return it->second;
+    }
+
+    os::SegList segList;
+
     /* I don't fully understand the SegList structures as they are build by
      * AmigaOS, but the following seems to apply:
      *
@@ -443,29 +591,39 @@ OSDebugger::read(const os::Process &pr, os::SegList &result) const
 
         os::CommandLineInterface cli;
         read(BPTR(pr.pr_CLI), &cli);
-        read(BPTR(cli.cli_Module), result);
+        read(BPTR(cli.cli_Module), segList);
 
     } else if (isValidPtr(BPTR(pr.pr_SegList))) {
         
         auto size = mem.spypeek32 <ACCESSOR_CPU> (BPTR(pr.pr_SegList));
         if (size >= 3) {
             auto addr = mem.spypeek32 <ACCESSOR_CPU> (BPTR(pr.pr_SegList) + 12);
-            read(BPTR(addr), result);
+            read(BPTR(addr), segList);
         }
     }
+
+    return cache.segLists[pr.addr] = std::move(segList);
 }
 
-void
-OSDebugger::read(u32 addr, os::SegList &result) const
+const os::TaskInfo *
+OSDebugger::findProcess(const string &name) const
 {
-    for (isize i = 0; isValidPtr(addr) && i < 128; i++) {
-        
-        auto size = mem.spypeek32 <ACCESSOR_CPU> (addr - 4) - 8;
-        auto next = mem.spypeek32 <ACCESSOR_CPU> (addr);
-        auto data = addr + 4;
-        
-        result.push_back(std::make_pair(data, size));
-        addr = BPTR(next);
+    for (auto &info : cachedTaskInfos()) {
+
+        if (!info.isProcess) continue;
+
+        if (!info.name.empty() && name == info.name) {
+            return &info;
+        }
+
+        string shortName = info.name.substr(0, info.name.find("."));
+        if (!shortName.empty() && name == shortName) {
+            return &info;
+        }
+
+        if (!info.command.empty() && name == info.command) {
+            return &info;
+        }
     }
+    return nullptr;
 }
-
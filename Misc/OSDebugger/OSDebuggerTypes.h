@@ -309,6 +309,27 @@ Process;
 
 typedef std::vector<std::pair<u32, u32>> SegList;
 
+// Summary of a task as returned by the batched task query of the OSDebugger
+typedef struct TaskInfo
+{
+    // The task structure
+    Task task = { };
+
+    // Name of the task
+    string name;
+
+    // The process structure (only valid if the task is a process)
+    bool isProcess = false;
+    Process process = { };
+
+    // Name of the loaded command (only set if a CLI is attached)
+    string command;
+
+    // The segment list of the process
+    SegList segList;
+}
+TaskInfo;
+
 typedef struct ExecBase
 {
     u32     addr;
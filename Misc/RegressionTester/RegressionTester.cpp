@@ -10,9 +10,13 @@
 #include "config.h"
 #include "RegressionTester.h"
 #include "Amiga.h"
+#include "Chrono.h"
 #include "IOUtils.h"
 
+#include <atomic>
 #include <fstream>
+#include <iomanip>
+#include <random>
 
 void
 RegressionTester::prepare(ConfigScheme scheme, string kickstart)
@@ -104,6 +108,220 @@ RegressionTester::dumpTexture(Amiga &amiga, std::ostream& os)
     }
 }
 
+void
+RegressionTester::benchmarkLineHooks(std::ostream& os, isize lines)
+{
+    using namespace util;
+
+    {   SUSPENDED
+
+        // The handlers modify the emulator state. Hence, we save it first
+        std::vector<u8> state(amiga.size());
+        amiga.save(state.data());
+
+        auto hooks = agnus.lineHooks();
+
+        auto measure = [&](auto hsync) {
+
+            Clock clock;
+            for (isize i = 0; i < lines; i++) {
+
+                hsync();
+
+                // Keep the compiler from merging the iterations
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+            }
+            return double(clock.stop().asNanoseconds()) / double(lines);
+        };
+
+        auto all = measure([&]() { hooks.hsync<false>(); });
+        auto fast = measure([&]() { hooks.hsync<true>(); });
+
+        // Restore the original state
+        amiga.load(state.data());
+
+        os << tab("Rasterlines") << dec(lines) << std::endl;
+        os << tab("All handlers");
+        os << std::fixed << std::setprecision(2) << all << " ns per line" << std::endl;
+        os << tab("With fast paths");
+        os << std::fixed << std::setprecision(2) << fast << " ns per line" << std::endl;
+    }
+}
+
+isize
+RegressionTester::checkSSE(std::ostream& os, isize lines)
+{
+    using namespace util;
+
+    constexpr isize len = isizeof(Denise::bBuffer);
+
+    struct Buffers {
+
+        u8 b[len];
+        u8 i[len];
+        u8 m[len];
+        u16 z[len];
+    };
+
+    auto save = [&](Buffers &buffers) {
+
+        std::memcpy(buffers.b, denise.bBuffer, sizeof(buffers.b));
+        std::memcpy(buffers.i, denise.iBuffer, sizeof(buffers.i));
+        std::memcpy(buffers.m, denise.mBuffer, sizeof(buffers.m));
+        std::memcpy(buffers.z, denise.zBuffer, sizeof(buffers.z));
+    };
+
+    auto restore = [&](const Buffers &buffers) {
+
+        std::memcpy(denise.bBuffer, buffers.b, sizeof(buffers.b));
+        std::memcpy(denise.iBuffer, buffers.i, sizeof(buffers.i));
+        std::memcpy(denise.mBuffer, buffers.m, sizeof(buffers.m));
+        std::memcpy(denise.zBuffer, buffers.z, sizeof(buffers.z));
+    };
+
+    auto seed = std::random_device()();
+    std::mt19937 rng(seed);
+    auto random = [&](isize range) { return isize(rng() % u32(range)); };
+
+    // Fills the bitplane buffer with random data of random density
+    auto randomize = [&]() {
+
+        u8 planes = u8(random(64));
+        isize density = random(5);
+
+        for (isize i = 0; i < len; i++) {
+            denise.bBuffer[i] = random(4) < density ? u8(rng()) & planes : 0;
+        }
+    };
+
+    // Number of checked lines and mismatches (SPF, DPF, DPF with PF2PRI, CLX)
+    isize checks[4] = { };
+    isize errors[4] = { };
+
+    {   SUSPENDED
+
+        auto backup = std::make_unique<Buffers>();
+        auto result = std::make_unique<Buffers>();
+        auto garbage = std::make_unique<Buffers>();
+        save(*backup);
+
+        //
+        // Translating bitplane data
+        //
+
+        for (isize line = 0; line < lines; line++) {
+
+            isize mode = line % 3;
+
+            u16 bplcon2 = u16(rng());
+            Denise::PFState state;
+            state.zpf1 = Denise::zPF1(bplcon2);
+            state.zpf2 = Denise::zPF2(bplcon2);
+            state.prio = mode == 2;
+            state.ham = random(2);
+
+            Pixel from = random(len + 1);
+            Pixel to = random(len + 1);
+            if (from > to) std::swap(from, to);
+
+            auto translate = [&](Pixel start, Pixel end) {
+
+                switch (mode) {
+
+                    case 0: denise.translateSPF(start, end, state); break;
+                    case 1: denise.translateDPF<false>(start, end, state); break;
+                    case 2: denise.translateDPF<true>(start, end, state); break;
+                }
+            };
+
+            // Let the target buffers start with random contents
+            randomize();
+            for (isize i = 0; i < len; i++) {
+                denise.iBuffer[i] = denise.mBuffer[i] = u8(rng());
+                denise.zBuffer[i] = u16(rng());
+            }
+            save(*garbage);
+
+            // Translate with the SSE code (the scalar code handles the rest)
+            translate(from, to);
+            save(*result);
+
+            // Translate in chunks that are too small for the SSE code
+            restore(*garbage);
+            for (Pixel p = from; p < to; p += 15) translate(p, std::min(p + 15, to));
+
+            checks[mode]++;
+            if (std::memcmp(result->i, denise.iBuffer, sizeof(result->i)) ||
+                std::memcmp(result->m, denise.mBuffer, sizeof(result->m)) ||
+                std::memcmp(result->z, denise.zBuffer, sizeof(result->z))) {
+
+                errors[mode]++;
+            }
+        }
+
+        //
+        // Checking for playfield collisions
+        //
+
+        for (isize line = 0; line < lines; line++) {
+
+            // Both enable masks are disjoint (see checkP2PCollisions())
+            u8 enabled1 = u8(rng()) & 0b010101;
+            u8 enabled2 = u8(rng()) & 0b101010;
+            u8 enabled = enabled1 | enabled2;
+            u8 compare = u8(rng()) & enabled;
+
+            // Remove all collisions and add a few at random positions
+            randomize();
+            if (enabled) {
+
+                for (isize i = 0; i < HPIXELS; i++) {
+                    if ((denise.bBuffer[i] & enabled) == compare) {
+                        denise.bBuffer[i] ^= enabled & -enabled;
+                    }
+                }
+                for (isize i = random(3); i > 0; i--) {
+
+                    isize pos = random(HPIXELS);
+                    denise.bBuffer[pos] = (denise.bBuffer[pos] & ~enabled) | compare;
+                }
+            }
+
+            // Find the first collision with the scalar code
+            Pixel first = 0;
+            while (first < HPIXELS && (denise.bBuffer[first] & enabled) != compare) first++;
+
+            // The SSE code must not skip a chunk with a collision
+            Pixel pos = denise.findP2PCollisionSSE(enabled, compare);
+            bool ok = pos <= first && pos % 16 == 0;
+
+#if defined(__SSE2__)
+            // It must skip all chunks without a collision
+            ok &= pos == std::min(first / 16 * 16, Pixel(HPIXELS / 16 * 16));
+#endif
+
+            checks[3]++;
+            if (!ok) errors[3]++;
+        }
+
+        restore(*backup);
+    }
+
+    const char *names[4] = {
+
+        "Single playfield", "Dual playfield", "Dual playfield (PF2PRI)", "Collisions"
+    };
+
+    os << tab("Random seed") << dec(seed) << std::endl;
+    for (isize i = 0; i < 4; i++) {
+
+        os << tab(names[i]);
+        os << dec(checks[i]) << " lines, " << dec(errors[i]) << " mismatches" << std::endl;
+    }
+
+    return errors[0] + errors[1] + errors[2] + errors[3];
+}
+
 void
 RegressionTester::setErrorCode(u8 value)
 {
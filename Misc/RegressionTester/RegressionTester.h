@@ -88,6 +88,34 @@ public:
     void dumpTexture(class Amiga &amiga, std::ostream& os);
 
     
+    //
+    // Benchmarking
+    //
+
+public:
+
+    /* Measures the time spent in Agnus::lineHooks() with and without the
+     * fast paths. The current emulator state is used as test case. It is
+     * restored when the benchmark has finished.
+     */
+    void benchmarkLineHooks(std::ostream& os, isize lines = 1000000) throws;
+
+
+    //
+    // Checking the SSE code
+    //
+
+public:
+
+    /* Compares the vectorized drawing functions of Denise with the scalar
+     * code. Random lines are translated in single-playfield mode and in
+     * dual-playfield mode with both priorities. In addition, the playfield
+     * collision check is run with random enable and compare masks. The
+     * function returns the number of mismatches.
+     */
+    isize checkSSE(std::ostream& os, isize lines = 10000);
+
+
     //
     // Handling errors
     //
@@ -63,26 +63,57 @@ GdbServer::getDefaultConfig()
     return defaults;
 }
 
-string
-GdbServer::doReceive()
+bool
+GdbServer::doReceive(Client &client, string &packet)
 {
-    auto cmd = connection.recv();
-    
-    // Remove LF and CR (if present)
-    cmd = util::rtrim(cmd, "\n\r");
+    return nextPacket(client.input, packet);
+}
 
-    if (config.verbose) {
-        retroShell << "R: " << util::makePrintable(cmd) << "\n";
+bool
+GdbServer::nextPacket(string &input, string &packet)
+{
+    while (!input.empty()) {
+
+        switch (input[0]) {
+
+            case '$':
+            {
+                // Check if the packet and its checksum are complete
+                auto pos = input.find('#');
+                if (pos == string::npos || pos + 3 > input.size()) {
+
+                    if ((isize)input.size() > 2 * maxPacketSize) {
+
+                        input.clear();
+                        throw VAError(ERROR_GDB_INVALID_FORMAT);
+                    }
+                    return false;
+                }
+                packet = input.substr(0, pos + 3);
+                input.erase(0, pos + 3);
+                return true;
+            }
+            case '-':
+            case 0x03:
+
+                packet = input.substr(0, 1);
+                input.erase(0, 1);
+                return true;
+
+            default:
+
+                // Skip acknowledgments and line breaks
+                input.erase(0, 1);
+                break;
+        }
     }
-
-    latestCmd = cmd;
-    return latestCmd;
+    return false;
 }
 
 void
 GdbServer::doSend(const string &payload)
 {
-    connection.send(payload);
+    enqueue(payload);
     
     if (config.verbose) {
         retroShell << "T: " << util::makePrintable(payload) << "\n";
@@ -92,10 +123,15 @@ GdbServer::doSend(const string &payload)
 void
 GdbServer::doProcess(const string &payload)
 {
+    if (config.verbose) {
+        retroShell << "R: " << util::makePrintable(payload) << "\n";
+    }
+
     try {
         
-        process(latestCmd);
-        
+        process(payload);
+        flush();
+
     } catch (VAError &err) {
         
         auto msg = "GDB server error: " + string(err.what());
@@ -237,10 +273,60 @@ GdbServer::readRegister(isize nr)
 }
 
 string
-GdbServer::readMemory(isize addr)
+GdbServer::readMemory(isize addr, isize count)
+{
+    std::vector<u8> data(count);
+    mem.spypeek((u32)addr, count, data.data());
+
+    return util::hexEncode(data.data(), count);
+}
+
+bool
+GdbServer::writeMemory(isize addr, const u8 *data, isize count)
+{
+    SUSPENDED
+
+    return mem.patch((u32)addr, count, data);
+}
+
+string
+GdbServer::memoryMap()
 {
-    auto byte = mem.spypeek8 <ACCESSOR_CPU> ((u32)addr);
-    return util::hexstr <2> (byte);
+    auto type = [&](isize bank) {
+
+        switch (mem.getMemSrc <ACCESSOR_CPU> ((u32)(bank << 16))) {
+
+            case MEM_NONE:          return "";
+            case MEM_ROM:
+            case MEM_ROM_MIRROR:
+            case MEM_WOM:
+            case MEM_EXT:           return "rom";
+
+            default:                return "ram";
+        }
+    };
+
+    string result =
+    "<?xml version=\"1.0\"?>\n"
+    "<!DOCTYPE memory-map PUBLIC \"+//IDN gnu.org//DTD GDB Memory Map V1.0//EN\" "
+    "\"http://sourceware.org/gdb/gdb-memory-map.dtd\">\n"
+    "<memory-map>\n";
+
+    // Merge adjacent banks of the same type into a single region
+    for (isize first = 0, last = 0; first < 256; first = last) {
+
+        string t = type(first);
+        for (last = first + 1; last < 256 && type(last) == t; last++);
+
+        if (!t.empty()) {
+
+            result += "<memory type=\"" + t + "\"";
+            result += " start=\"0x" + util::hexstr <8> (first << 16) + "\"";
+            result += " length=\"0x" + util::hexstr <8> ((last - first) << 16) + "\"/>\n";
+        }
+    }
+
+    return result + "</memory-map>\n";
 }
 
 void
@@ -252,4 +338,5 @@ GdbServer::breakpointReached()
     
     debug(GDB_DEBUG, "breakpointReached()\n");
     process <'?'> ("");
+    flush();
 }
@@ -28,11 +28,15 @@ enum class GdbCmd
     TfV,
     TfP,
     TStatus,
+    Xfer,
     fThreadInfo,
 };
 
 class GdbServer : public RemoteServer {
 
+    // Maximum packet size announced to the client
+    static constexpr isize maxPacketSize = 0x4000;
+
     // The name of the process to be debugged
     string processName;
     
@@ -73,7 +77,7 @@ public:
     
     ServerConfig getDefaultConfig() override;
     bool shouldRun() override;
-    string doReceive() override throws;
+    bool doReceive(Client &client, string &packet) override throws;
     void doSend(const string &payload) override throws;
     void doProcess(const string &payload) override throws;
     void didStart() override;
@@ -129,6 +133,9 @@ private:
     template <char letter> void process(string arg) throws;
     template <char letter, GdbCmd cmd> void process(string arg) throws;
     
+    // Extracts the next complete packet from the received data
+    bool nextPacket(string &input, string &packet) throws;
+
     // Sends a packet with control characters and a checksum attached
     void reply(const string &payload);
 
@@ -140,8 +147,14 @@ private:
     // Reads a register value
     string readRegister(isize nr);
 
-    // Reads a byte from memory
-    string readMemory(isize addr);
+    // Reads a block of memory and returns it in hexadecimal format
+    string readMemory(isize addr, isize count);
+
+    // Writes a block of memory (returns false if some bytes are read-only)
+    bool writeMemory(isize addr, const u8 *data, isize count);
+
+    // Describes the memory layout in the XML format used by GDB
+    string memoryMap();
     
     
     //
@@ -16,6 +16,7 @@
 #include "MemUtils.h"
 #include "MsgQueue.h"
 #include "RetroShell.h"
+#include <algorithm>
 
 template <> void
 GdbServer::process <' ', GdbCmd::CtrlC> (string arg)
@@ -29,9 +30,11 @@ GdbServer::process <' ', GdbCmd::CtrlC> (string arg)
 template <> void
 GdbServer::process <'q', GdbCmd::Supported> (string arg)
 {
-    reply("PacketSize=1ff;"
+    reply("PacketSize=" + util::hexstr <4> (maxPacketSize) + ";"
           "multiprocess-;"
           "swbreak+;"
+          "hwbreak+;"
+          "qXfer:memory-map:read+;"
           "QStartNoAckMode+;"
           "vContSupported+");
 }
@@ -72,6 +75,35 @@ GdbServer::process <'q', GdbCmd::TfP> (string arg)
     reply("l");
 }
 
+template <> void
+GdbServer::process <'q', GdbCmd::Xfer> (string arg)
+{
+    // Format: Xfer:memory-map:read::<offset>,<length>
+    auto tokens = util::split(arg, ':');
+
+    if (tokens.size() != 5 || tokens[1] != "memory-map" || tokens[2] != "read") {
+
+        reply("");
+        return;
+    }
+
+    auto range = util::split(tokens[4], ',');
+    isize offset, length;
+
+    if (range.size() != 2 ||
+        !util::parseHex(range[0], &offset) || !util::parseHex(range[1], &length)) {
+        throw VAError(ERROR_GDB_INVALID_FORMAT, "qXfer");
+    }
+
+    // Transmit the requested part of the map ('l' marks the last part)
+    auto map = memoryMap();
+    offset = std::min(offset, (isize)map.size());
+    length = std::min(length, maxPacketSize - 5);
+
+    auto data = map.substr(offset, length);
+    reply((offset + (isize)data.size() < (isize)map.size() ? "m" : "l") + data);
+}
+
 template <> void
 GdbServer::process <'q', GdbCmd::fThreadInfo> (string arg)
 {
@@ -217,6 +249,11 @@ GdbServer::process <'q'> (string cmd)
         process <'q', GdbCmd::C> ("");
         return;
     }
+    if (command == "Xfer") {
+
+        process <'q', GdbCmd::Xfer> (cmd);
+        return;
+    }
     
     throw VAError(ERROR_GDB_UNSUPPORTED_CMD, "q");
 }
@@ -305,18 +342,15 @@ GdbServer::process <'m'> (string cmd)
     
     if (tokens.size() == 2) {
 
-        string result;
-
         isize addr;
         util::parseHex(tokens[0], &addr);
         isize size;
         util::parseHex(tokens[1], &size);
 
-        for (isize i = 0; i < size; i++) {
-            result += readMemory(addr + i);
-        }
-        
-        reply(result);
+        // The reply may contain fewer bytes than requested
+        size = std::clamp(size, isize(0), (maxPacketSize - 4) / 2);
+
+        reply(readMemory(addr, size));
 
     } else {
     
@@ -327,7 +361,54 @@ GdbServer::process <'m'> (string cmd)
 template <> void
 GdbServer::process <'M'> (string cmd)
 {
-    throw VAError(ERROR_GDB_UNSUPPORTED_CMD, "M");
+    // Format: M<addr>,<length>:<hex data>
+    auto colon = cmd.find(':');
+    auto tokens = util::split(cmd.substr(0, colon), ',');
+    isize addr, size;
+
+    if (colon == string::npos || tokens.size() != 2 ||
+        !util::parseHex(tokens[0], &addr) || !util::parseHex(tokens[1], &size) ||
+        size < 0 || size > maxPacketSize) {
+        throw VAError(ERROR_GDB_INVALID_FORMAT, "M");
+    }
+
+    std::vector<u8> data(size);
+    if (!util::hexDecode(cmd.substr(colon + 1), data.data(), size)) {
+        throw VAError(ERROR_GDB_INVALID_FORMAT, "M");
+    }
+
+    reply(writeMemory(addr, data.data(), size) ? "OK" : "E01");
+}
+
+template <> void
+GdbServer::process <'X'> (string cmd)
+{
+    // Format: X<addr>,<length>:<binary data>
+    auto colon = cmd.find(':');
+    auto tokens = util::split(cmd.substr(0, colon), ',');
+    isize addr, size;
+
+    if (colon == string::npos || tokens.size() != 2 ||
+        !util::parseHex(tokens[0], &addr) || !util::parseHex(tokens[1], &size) ||
+        size < 0 || size > maxPacketSize) {
+        throw VAError(ERROR_GDB_INVALID_FORMAT, "X");
+    }
+
+    // Remove the escape characters ('}' followed by the original byte ^ 0x20)
+    std::vector<u8> data;
+    data.reserve(size);
+
+    for (auto i = colon + 1; i < cmd.size(); i++) {
+
+        if (cmd[i] == '}' && i + 1 < cmd.size()) {
+            data.push_back((u8)(cmd[++i] ^ 0x20));
+        } else {
+            data.push_back((u8)cmd[i]);
+        }
+    }
+    if ((isize)data.size() != size) throw VAError(ERROR_GDB_INVALID_FORMAT, "X");
+
+    reply(writeMemory(addr, data.data(), size) ? "OK" : "E01");
 }
 
 template <> void
@@ -367,7 +448,8 @@ GdbServer::process <'Z'> (string cmd)
         auto addr = std::stol(tokens[1], 0, 16);
         // auto kind = std::stol(tokens[2]);
                 
-        if (type == 0) {
+        // Software and hardware breakpoints are handled alike
+        if (type == 0 || type == 1) {
          
             cpu.debugger.breakpoints.addAt((u32)addr);
         }
@@ -393,7 +475,7 @@ GdbServer::process <'z'> (string cmd)
         
         printf("z: type = %ld addr = $%lx kind = %ld\n", type, addr, kind);
         
-        if (type == 0) {
+        if (type == 0 || type == 1) {
          
             cpu.debugger.breakpoints.removeAt((u32)addr);
         }
@@ -441,7 +523,7 @@ GdbServer::process(string package)
                 
             } else {
                 
-                if (ackMode) connection.send("-");
+                if (ackMode) { send("-"); flush(); }
                 throw VAError(ERROR_GDB_INVALID_CHECKSUM);
             }
             
@@ -470,6 +552,7 @@ GdbServer::process(char cmd, string package)
         case 'k' : process <'k'> (package); break;
         case 'm' : process <'m'> (package); break;
         case 'M' : process <'M'> (package); break;
+        case 'X' : process <'X'> (package); break;
         case 'p' : process <'p'> (package); break;
         case 'P' : process <'P'> (package); break;
         case 'c' : process <'c'> (package); break;
@@ -10,8 +10,12 @@
 #include "config.h"
 #include "RemoteManager.h"
 #include "IOUtils.h"
+#include "MsgQueue.h"
+#include "RetroShell.h"
 #include "Scheduler.h"
 #include "SerialPort.h"
+#include <algorithm>
+#include <iterator>
 
 RemoteManager::RemoteManager(Amiga& ref) : SubComponent(ref)
 {
@@ -21,6 +25,38 @@ RemoteManager::RemoteManager(Amiga& ref) : SubComponent(ref)
         &rshServer,
         &gdbServer
     };
+
+#ifndef _WIN32
+    // Create the pipe for interrupting the reactor
+    if (pipe(wakePipe) == 0) {
+
+        fcntl(wakePipe[0], F_SETFL, O_NONBLOCK);
+        fcntl(wakePipe[1], F_SETFL, O_NONBLOCK);
+
+    } else {
+
+        wakePipe[0] = wakePipe[1] = -1;
+    }
+#endif
+
+    // Launch the I/O reactor
+    reactor = std::thread(&RemoteManager::reactorLoop, this);
+}
+
+RemoteManager::~RemoteManager()
+{
+    // Terminate the I/O reactor
+    quit = true;
+    wakeUp();
+    if (reactor.joinable()) reactor.join();
+
+#ifndef _WIN32
+    for (auto &fd : wakePipe) {
+        
+        if (fd >= 0) close(fd);
+        fd = -1;
+    }
+#endif
 }
 
 void
@@ -39,7 +75,9 @@ RemoteManager::_dump(dump::Category category, std::ostream& os) const
             os << "Off" << std::endl;
         } else {
             os << "Port " << dec(port);
-            os << " (" << SrvStateEnum::key(server->state) << ")" << std::endl;
+            os << " (" << SrvStateEnum::key(server->state);
+            if (server->isConnected()) os << ", " << dec(server->numClients()) << " client(s)";
+            os << ")" << std::endl;
         }
     }
 }
@@ -112,6 +150,256 @@ RemoteManager::numErroneous() const
     return result;
 }
 
+void
+RemoteManager::wakeUp()
+{
+#ifndef _WIN32
+    if (wakePipe[1] >= 0) {
+
+        u8 byte = 0;
+        [[maybe_unused]] auto n = write(wakePipe[1], &byte, 1);
+    }
+#endif
+}
+
+void
+RemoteManager::processPackets()
+{
+    if (!pending) return;
+
+    // Take over all pending events
+    std::vector<Delivery> batch;
+    synchronized {
+
+        batch.swap(deliveries);
+        pending = false;
+    }
+
+    for (auto &delivery : batch) {
+
+        auto &server = *delivery.server;
+
+        // Skip all events referring to sockets that have been closed meanwhile
+        isize generation, clients;
+        {   util::AutoMutex _am(server.mutex);
+
+            generation = server.generation;
+            clients = server.numClients();
+        }
+        if (delivery.generation != generation) continue;
+
+        try {
+
+            switch (delivery.type) {
+
+                case Delivery::Type::Connect:
+
+                    if (!server.isConnected()) {
+
+                        server.numReceived = 0;
+                        server.numSent = 0;
+                        server.switchState(SRV_STATE_CONNECTED);
+                    }
+                    server.didAddClient(delivery.client);
+                    break;
+
+                case Delivery::Type::Packet:
+
+                    msgQueue.put(MSG_SRV_RECEIVE, ++server.numReceived);
+                    server.process(delivery.payload);
+                    break;
+
+                case Delivery::Type::Disconnect:
+
+                    if (!delivery.payload.empty()) {
+                        retroShell << "Server Error: " << delivery.payload << '\n';
+                    }
+
+                    // Wait for new clients if the last client has left
+                    if (clients == 0 && server.isConnected()) {
+
+                        server.switchState(SRV_STATE_LISTENING);
+                        if (!server.listener.isOpen()) server.establish();
+                    }
+                    break;
+            }
+
+        } catch (std::exception &err) {
+
+            retroShell << "Server Error: " << string(err.what()) << '\n';
+
+            // Terminate the session or shut down the server if it is unusable
+            server.isConnected() ? server._disconnect() : server._stop();
+        }
+    }
+}
+
+void
+RemoteManager::reactorLoop()
+{
+    // Location of the sockets of a single server inside the poll set
+    struct Range { isize first; isize count; isize generation; };
+
+    std::vector<struct pollfd> fds;
+    std::vector<Range> ranges(servers.size());
+    std::vector<Delivery> batch;
+
+    while (!quit) {
+
+        fds.clear();
+
+#ifndef _WIN32
+        fds.push_back({ wakePipe[0], POLLIN, 0 });
+#endif
+
+        // Collect the sockets of all servers
+        for (usize i = 0; i < servers.size(); i++) {
+
+            auto &server = *servers[i];
+            util::AutoMutex _am(server.mutex);
+
+            ranges[i] = { (isize)fds.size(), 0, server.generation };
+
+            if (server.listener.isOpen()) {
+                fds.push_back({ server.listener.getId(), POLLIN, 0 });
+            }
+            for (auto &client : server.clients) {
+
+                short events = server.canReceive(client) ? POLLIN : 0;
+                if (client.socket.hasPendingData()) events |= POLLOUT;
+                fds.push_back({ client.socket.getId(), events, 0 });
+            }
+            ranges[i].count = (isize)fds.size() - ranges[i].first;
+        }
+
+        // Wait for something to happen
+#ifdef _WIN32
+        if (fds.empty()) {
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(pollTimeout));
+            continue;
+        }
+        auto n = WSAPoll(fds.data(), (ULONG)fds.size(), pollTimeout);
+#else
+        auto n = poll(fds.data(), (nfds_t)fds.size(), pollTimeout);
+
+        // Empty the wake-up pipe
+        if (fds[0].revents & POLLIN) {
+
+            u8 buffer[64];
+            while (read(wakePipe[0], buffer, sizeof(buffer)) > 0) { }
+        }
+#endif
+        if (n < 0) continue;
+
+        // Serve all servers (even on timeout to process postponed input)
+        for (usize i = 0; i < servers.size(); i++) {
+
+            auto &range = ranges[i];
+            serve(*servers[i], range.generation, fds.data() + range.first, range.count, batch);
+        }
+
+        // Hand the collected events over to the emulator thread
+        if (!batch.empty()) {
+
+            synchronized {
+
+                std::move(batch.begin(), batch.end(), std::back_inserter(deliveries));
+                pending = true;
+            }
+            batch.clear();
+        }
+    }
+}
+
+void
+RemoteManager::serve(RemoteServer &server, isize generation,
+                     const struct pollfd *fds, isize count,
+                     std::vector<Delivery> &batch)
+{
+    util::AutoMutex _am(server.mutex);
+
+    // Ignore the poll results if the sockets have been changed meanwhile
+    if (server.generation != generation) return;
+
+    auto fd = fds;
+    auto watched = (isize)server.clients.size();
+
+    auto deliver = [&](Delivery::Type type, isize client, const string &payload) {
+        batch.push_back(Delivery { type, &server, generation, client, payload });
+    };
+
+    // Accept new clients
+    if (server.listener.isOpen()) {
+
+        while (fd->revents & POLLIN) {
+
+            Socket socket;
+            try { socket = server.listener.accept(); } catch (...) { break; }
+
+            // Reject the client if the server is fully booked
+            if (server.numClients() >= server.maxClients) {
+
+                debug(SRV_DEBUG, "Rejecting client\n");
+                continue;
+            }
+
+            socket.setBlocking(false);
+            auto id = server.nextClient++;
+            server.clients.push_back({ id, std::move(socket), "" });
+            deliver(Delivery::Type::Connect, id, "");
+        }
+        fd++;
+    }
+
+    // Serve the clients
+    for (isize i = 0; i < watched; i++, fd++) {
+
+        auto &client = server.clients[i];
+        bool closed = false;
+        string error;
+
+        if (fd->revents & (POLLIN | POLLHUP | POLLERR | POLLNVAL)) {
+
+            // Receive data
+            try { client.input += client.socket.recv(); } catch (...) { closed = true; }
+        }
+
+        // Split the received data into packets
+        if (!client.input.empty()) {
+
+            try {
+
+                string packet;
+                while (server.doReceive(client, packet)) {
+                    deliver(Delivery::Type::Packet, client.id, packet);
+                }
+
+            } catch (std::exception &err) {
+
+                closed = true;
+                error = err.what();
+            }
+        }
+
+        // Transmit buffered data
+        if (!closed && client.socket.hasPendingData()) {
+            try { client.socket.flush(); } catch (...) { closed = true; }
+        }
+
+        if (closed) {
+
+            debug(SRV_DEBUG, "Client %ld disconnected\n", client.id);
+            client.socket.close();
+            deliver(Delivery::Type::Disconnect, client.id, error);
+        }
+    }
+
+    // Remove all closed connections
+    std::erase_if(server.clients, [](const RemoteServer::Client &c) {
+        return !c.socket.isOpen(); });
+}
+
 void
 RemoteManager::serviceServerEvent()
 {
@@ -128,6 +416,11 @@ RemoteManager::serviceServerEvent()
         gdbServer.shouldRun() ? gdbServer._start() : gdbServer._stop();
     }
 
+    // Restart the serial transfer if the event has been lost (e.g., by a reset)
+    if (serServer.isConnected() || serServer.hasPty()) {
+        serServer.scheduleFirstEvent();
+    }
+
     // Schedule next event
     scheduler.scheduleInc <SLOT_SRV> (SEC(0.5), SRV_LAUNCH_DAEMON);
 }
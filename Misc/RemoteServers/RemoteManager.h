@@ -14,9 +14,52 @@
 #include "SerServer.h"
 #include "RshServer.h"
 #include "GdbServer.h"
+#include <atomic>
+#include <thread>
+
+/* The remote manager runs a single I/O reactor thread which serves the
+ * sockets of all remote servers. The reactor waits for socket events with
+ * poll(), accepts new clients, collects incoming data, and transmits buffered
+ * output that could not be sent right away. It never touches the emulator
+ * state. Instead, received packets and connection changes are queued and
+ * handed over to the emulator thread, which processes them in batches
+ * whenever it reaches a safe point (see Thread::serviceRequests()).
+ */
 
 class RemoteManager : public SubComponent {
 
+    // An event waiting to be processed by the emulator thread
+    struct Delivery {
+
+        enum class Type { Connect, Disconnect, Packet };
+
+        Type type;
+        RemoteServer *server;
+
+        // The server generation when the event occurred
+        isize generation;
+
+        // The client causing the event
+        isize client;
+
+        // The received packet or an error message
+        string payload;
+    };
+
+    // Events waiting to be processed
+    std::vector<Delivery> deliveries;
+    std::atomic<bool> pending = false;
+
+    // The I/O reactor
+    std::thread reactor;
+    std::atomic<bool> quit = false;
+
+    // Pipe for interrupting poll() (unused on Windows)
+    int wakePipe[2] = { -1, -1 };
+
+    // Maximum time the reactor blocks in poll() (milliseconds)
+    static constexpr int pollTimeout = 50;
+
 public:
     
     // The remote servers
@@ -37,7 +80,7 @@ public:
 public:
     
     RemoteManager(Amiga& ref);
-    // ~RemoteManager();
+    ~RemoteManager();
     
     
     //
@@ -87,6 +130,29 @@ public:
     isize numErroneous() const;
 
  
+    //
+    // Running the I/O reactor
+    //
+
+public:
+
+    // Interrupts the reactor to let it pick up changed sockets or output
+    void wakeUp();
+
+    // Processes all pending events (called inside the emulator thread)
+    void processPackets();
+
+private:
+
+    // Main loop of the reactor thread
+    void reactorLoop();
+
+    // Serves the socket events of a single server
+    void serve(RemoteServer &server, isize generation,
+               const struct pollfd *fds, isize count,
+               std::vector<Delivery> &batch);
+
+    
     //
     // Servicing events
     //
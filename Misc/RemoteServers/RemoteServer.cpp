@@ -48,6 +48,8 @@ RemoteServer::_dump(dump::Category category, std::ostream& os) const
     if (category & dump::State) {
         os << tab("State");
         os << SrvStateEnum::key(state) << std::endl;
+        os << tab("Connected clients");
+        os << dec(numClients()) << std::endl;
         os << tab("Received packets");
         os << dec(numReceived) << std::endl;
         os << tab("Transmitted packets");
@@ -146,11 +148,19 @@ RemoteServer::_start()
         debug(SRV_DEBUG, "Starting server...\n");
         switchState(SRV_STATE_STARTING);
         
-        // Make sure we continue with a terminated server thread
-        if (serverThread.joinable()) serverThread.join();
-        
-        // Spawn a new thread
-        serverThread = std::thread(&RemoteServer::main, this);
+        try {
+
+            establish();
+
+        } catch (std::exception &err) {
+
+            handleError(err.what());
+
+            // Stay off (will be restarted by the launch daemon in auto-run mode)
+            closeClients();
+            synchronized { listener.close(); generation++; }
+            switchState(SRV_STATE_OFF);
+        }
     }
 }
 
@@ -162,11 +172,9 @@ RemoteServer::_stop()
         debug(SRV_DEBUG, "Stopping server...\n");
         switchState(SRV_STATE_STOPPING);
         
-        // Interrupt the server thread
-        _disconnect();
-        
-        // Wait until the server thread has terminated
-        if (serverThread.joinable()) serverThread.join();
+        // Close all sockets
+        closeClients();
+        synchronized { listener.close(); generation++; }
         
         switchState(SRV_STATE_OFF);
     }
@@ -177,9 +185,69 @@ RemoteServer::_disconnect()
 {
     debug(SRV_DEBUG, "Disconnecting...\n");
     
-    // Trigger an exception inside the server thread
-    connection.close();
-    listener.close();
+    closeClients();
+
+    // Wait for new clients
+    if (isConnected()) {
+
+        switchState(SRV_STATE_LISTENING);
+        if (!listener.isOpen()) establish();
+    }
+}
+
+void
+RemoteServer::establish()
+{
+    switchState(SRV_STATE_LISTENING);
+
+    try {
+
+        // Try to be a client by connecting to an existing server
+        Socket socket;
+        socket.connect(config.port);
+        socket.setBlocking(false);
+        debug(SRV_DEBUG, "Acting as a client\n");
+
+        isize id = 0;
+        synchronized {
+
+            id = nextClient++;
+            clients.push_back(Client { id, std::move(socket), "" });
+            generation++;
+        }
+        switchState(SRV_STATE_CONNECTED);
+        didAddClient(id);
+
+    } catch (...) {
+
+        // If there is no existing server, be the server
+        debug(SRV_DEBUG, "Acting as a server\n");
+
+        // Create a port listener and let the I/O reactor wait for clients
+        synchronized {
+
+            listener.close();
+            generation++;
+            listener.bind(config.port);
+            listener.listen();
+            listener.setBlocking(false);
+        }
+    }
+
+    remoteManager.wakeUp();
+}
+
+void
+RemoteServer::closeClients()
+{
+    synchronized {
+
+        for (auto &client : clients) client.socket.close();
+        clients.clear();
+        generation++;
+    }
+
+    remoteManager.wakeUp();
 }
 
 void
@@ -203,20 +271,6 @@ RemoteServer::switchState(SrvState newState)
     }
 }
 
-string
-RemoteServer::receive()
-{
-    string packet;
-    
-    if (isConnected()) {
-        
-        packet = doReceive();
-        msgQueue.put(MSG_SRV_RECEIVE, ++numReceived);
-    }
-    
-    return packet;
-}
-
 void
 RemoteServer::send(const string &packet)
 {
@@ -262,94 +316,39 @@ RemoteServer::process(const string &payload)
 }
 
 void
-RemoteServer::main()
-{    
-    try {
-        
-        mainLoop();
-        
-    } catch (std::exception &err) {
+RemoteServer::enqueue(const string &data)
+{
+    synchronized {
 
-        debug(SRV_DEBUG, "Server thread interrupted\n");
-        handleError(err.what());
+        for (auto &client : clients) client.socket.send(data);
     }
 }
 
 void
-RemoteServer::mainLoop()
+RemoteServer::enqueue(isize client, const string &data)
 {
-    switchState(SRV_STATE_LISTENING);
-            
-    while (isListening()) {
-        
-        try {
-            
-            try {
-                
-                // Try to be a client by connecting to an existing server
-                connection.connect(config.port);
-                debug(SRV_DEBUG, "Acting as a client\n");
-                
-            } catch (...) {
-                
-                // If there is no existing server, be the server
-                debug(SRV_DEBUG, "Acting as a server\n");
-                
-                // Create a port listener
-                listener.bind(config.port);
-                listener.listen();
-                
-                // Wait for a client to connect
-                connection = listener.accept();
-            }
-            
-            // Handle the session
-            sessionLoop();
-            
-            // Close the port listener
-            listener.close();
-            
-        } catch (std::exception &err) {
-            
-            debug(SRV_DEBUG, "Main loop interrupted\n");
+    synchronized {
 
-            // Handle error if we haven't been interrupted purposely
-            if (!isStopping()) handleError(err.what());
-        }
+        for (auto &c : clients) if (c.id == client) c.socket.send(data);
     }
-    
-    switchState(SRV_STATE_OFF);
 }
 
 void
-RemoteServer::sessionLoop()
+RemoteServer::flush()
 {
-    switchState(SRV_STATE_CONNECTED);
-    
-    numReceived = 0;
-    numSent = 0;
+    bool pending = false;
 
-    try {
-                
-        // Receive and process packets
-        while (1) { process(receive()); }
-        
-    } catch (std::exception &err) {
-                     
-        debug(SRV_DEBUG, "Session loop interrupted\n");
+    synchronized {
 
-        // Handle error if we haven't been interrupted purposely
-        if (!isStopping()) {
-            
-            handleError(err.what());
-            switchState(SRV_STATE_LISTENING);
+        for (auto &client : clients) {
+
+            // Broken connections are detected and closed by the I/O reactor
+            try { pending |= !client.socket.flush(); } catch (...) { }
         }
     }
 
-    numReceived = 0;
-    numSent = 0;
-
-    connection.close();
+    // Let the I/O reactor transmit the remaining data
+    if (pending) remoteManager.wakeUp();
 }
 
 void
@@ -13,7 +13,7 @@
 #include "SubComponent.h"
 #include "Socket.h"
 #include "Thread.h"
-#include <thread>
+#include <vector>
 
 class RemoteServer : public SubComponent {
         
@@ -21,15 +21,40 @@ class RemoteServer : public SubComponent {
         
 protected:
     
+    // A connected client
+    struct Client {
+
+        // Unique identifier
+        isize id;
+
+        // The socket connected to the client
+        Socket socket;
+
+        // Received data that has not been split into packets yet
+        string input;
+    };
+
     // Current configuration
     ServerConfig config = {};
 
-    // Sockets
+    // The port listener (closed if we act as a client of another instance)
     Socket listener;
-    Socket connection;
 
-    // The server thread
-    std::thread serverThread;
+    // All connected clients
+    std::vector<Client> clients;
+
+    // Maximum number of simultaneously connected clients
+    isize maxClients = 1;
+
+    // Identifier of the next connecting client
+    isize nextClient = 0;
+
+    /* Incremented whenever a socket is opened or closed outside the I/O
+     * reactor of the remote manager. It enables the reactor to ignore outdated
+     * poll results and the emulator thread to drop packets that were received
+     * before.
+     */
+    isize generation = 0;
         
     // The current server state
     SrvState state = SRV_STATE_OFF;
@@ -117,6 +142,9 @@ public:
     bool isStopping() const { return state == SRV_STATE_STOPPING; }
     bool isErroneous() const { return state == SRV_STATE_ERROR; }
 
+    // Returns the number of connected clients
+    isize numClients() const { return (isize)clients.size(); }
+
     
     //
     // Starting and stopping the server
@@ -130,7 +158,7 @@ public:
     // Shuts down the remote server
     void stop() throws { SUSPENDED _stop(); }
 
-    // Disconnects the client
+    // Disconnects all clients
     void disconnect() throws { SUSPENDED _disconnect(); }
 
 protected:
@@ -140,6 +168,12 @@ protected:
     void _stop() throws;
     void _disconnect() throws;
     
+    // Connects to another instance or waits for clients to connect
+    void establish() throws;
+
+    // Closes all client sockets
+    void closeClients();
+
     // Switches the internal state
     void switchState(SrvState newState);
     
@@ -152,29 +186,12 @@ private:
     // virtual bool canRun() { return true; }
     
     
-    //
-    // Running the server
-    //
-    
-private:
-    
-    // The main thread function
-    void main();
-
-    // Inner loops (called from main)
-    void mainLoop() throws;
-    void sessionLoop();
-    
-    
     //
     // Transmitting and processing packets
     //
     
 public:
     
-    // Receives or packet
-    string receive() throws;
-    
     // Sends a packet
     void send(const string &payload) throws;
     void send(char payload) throws;
@@ -191,6 +208,17 @@ public:
  
     // Processes a package
     void process(const string &payload) throws;
+
+protected:
+
+    // Adds data to the output buffer of all clients or a single client
+    void enqueue(const string &data);
+    void enqueue(isize client, const string &data);
+
+    /* Transmits the buffered data without blocking. Data that cannot be sent
+     * right away is transmitted later by the I/O reactor.
+     */
+    void flush();
     
 private:
         
@@ -204,7 +232,14 @@ private:
 
 private:
     
-    virtual string doReceive() throws = 0;
+    // Checks if the I/O reactor should read more data from a client
+    virtual bool canReceive(const Client &client) const { return true; }
+
+    /* Extracts the next packet from the data received by a client. The
+     * function is called by the I/O reactor and returns false if no complete
+     * packet is available yet.
+     */
+    virtual bool doReceive(Client &client, string &packet) throws = 0;
     virtual void doSend(const string &payload) throws = 0;
     virtual void doProcess(const string &payload) throws = 0;
     
@@ -218,4 +253,5 @@ private:
     virtual void didStop() { };
     virtual void didConnect() { };
     virtual void didDisconnect() { };
+    virtual void didAddClient(isize client) { };
 };
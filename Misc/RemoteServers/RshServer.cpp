@@ -15,7 +15,8 @@
 
 RshServer::RshServer(Amiga& ref) : RemoteServer(ref)
 {
-
+    // Allow multiple clients to observe and control RetroShell
+    maxClients = maxObservers;
 }
 
 void
@@ -48,43 +49,55 @@ RshServer::didStart()
 }
 
 void
-RshServer::didConnect()
+RshServer::didAddClient(isize client)
 {
     if (config.verbose) {
         
-        try {
-            
-            send("vAmiga RetroShell Remote Server ");
-            send(std::to_string(VER_MAJOR) + ".");
-            send(std::to_string(VER_MINOR) + ".");
-            send(std::to_string(VER_SUBMINOR));
-            send(" (" __DATE__ " " __TIME__ ")\n\n");
-            send("Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de\n");
-            send("Licensed under the GNU General Public License v3\n\n");
-            send("Type 'help' for help.\n");
-            send("\n");
-            send(retroShell.getPrompt());
-            
-        } catch (...) { };
+        string banner;
+
+        banner += "vAmiga RetroShell Remote Server ";
+        banner += std::to_string(VER_MAJOR) + ".";
+        banner += std::to_string(VER_MINOR) + ".";
+        banner += std::to_string(VER_SUBMINOR);
+        banner += " (" __DATE__ " " __TIME__ ")\n\n";
+        banner += "Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de\n";
+        banner += "Licensed under the GNU General Public License v3\n\n";
+        banner += "Type 'help' for help.\n";
+        banner += "\n";
+        banner += retroShell.getPrompt();
+
+        // Only greet the new client
+        enqueue(client, translate(banner));
+        flush();
     }
 }
 
-string
-RshServer::doReceive()
+bool
+RshServer::doReceive(Client &client, string &packet)
 {
-    string payload = connection.recv();
-    
+    // Wait until a complete line has arrived
+    auto pos = client.input.find('\n');
+    if (pos == string::npos) return false;
+
     // Remove LF and CR (if present)
-    payload = util::rtrim(payload, "\n\r");
+    packet = util::rtrim(client.input.substr(0, pos), "\n\r");
+    client.input.erase(0, pos + 1);
 
     // Ask the client to delete the input (will be replicated by RetroShell)
-    send("\033[A\33[2K\r");
+    client.socket.send("\033[A\33[2K\r");
     
-    return payload;
+    return true;
 }
 
 void
 RshServer::doSend(const string &payload)
+{
+    enqueue(translate(payload));
+    flush();
+}
+
+string
+RshServer::translate(const string &payload) const
 {
     string mapped;
     
@@ -109,7 +122,7 @@ RshServer::doSend(const string &payload)
         }
     }
     
-    connection.send(mapped);
+    return mapped;
 }
 
 void
@@ -12,6 +12,9 @@
 #include "RemoteServer.h"
 
 class RshServer : public RemoteServer {
+
+    // Maximum number of simultaneously connected clients
+    static constexpr isize maxObservers = 16;
   
 public:
     
@@ -32,9 +35,14 @@ protected:
     //
     
     ServerConfig getDefaultConfig() override;
-    string doReceive() override throws;
+    bool doReceive(Client &client, string &packet) override throws;
     void doProcess(const string &packet) override throws;
     void doSend(const string &packet) override throws;
     void didStart() override;
-    void didConnect() override;
+    void didAddClient(isize client) override;
+
+private:
+
+    // Translates RetroShell output into terminal output
+    string translate(const string &payload) const;
 };
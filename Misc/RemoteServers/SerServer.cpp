@@ -17,10 +17,28 @@
 #include "Thread.h"
 #include "UART.h"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
 SerServer::SerServer(Amiga& ref) : RemoteServer(ref)
 {
 }
 
+SerServer::~SerServer()
+{
+    ptyQuit = true;
+    if (ptyThread.joinable()) ptyThread.join();
+
+#ifndef _WIN32
+    if (pty >= 0) close(pty);
+#endif
+}
+
 void
 SerServer::_dump(dump::Category category, std::ostream& os) const
 {
@@ -30,6 +48,8 @@ SerServer::_dump(dump::Category category, std::ostream& os) const
     
     if (category & dump::State) {
         
+        os << tab("Pseudo terminal");
+        os << (hasPty() ? ptyName : "none") << std::endl;
         os << tab("Received bytes");
         os << dec(receivedBytes) << std::endl;
         os << tab("Transmitted bytes");
@@ -62,24 +82,38 @@ SerServer::getDefaultConfig()
     return defaults;
 }
 
-string
-SerServer::doReceive()
+bool
+SerServer::canReceive(const Client &client) const
 {
-    auto result = connection.recv();
-    receivedBytes += (isize)result.size();
-    
-    if (config.verbose) {
-        retroShell << "R: " << util::makePrintable(result) << "\n";
-    }
+    // Keep the data in the socket until the ring buffer has space again
+    return client.input.empty();
+}
+
+bool
+SerServer::doReceive(Client &client, string &packet)
+{
+    // Ignore the socket if the pseudo terminal is in use
+    if (hasPty()) { client.input.clear(); return false; }
+
+    // Move as many bytes as possible into the ring buffer
+    auto count = buffer.write((const u8 *)client.input.data(), (isize)client.input.size());
+    if (count == 0) return false;
+
+    receivedBytes += count;
 
-    return result;
+    // Pass the bytes on to the emulator thread for logging
+    packet = client.input.substr(0, count);
+    client.input.erase(0, count);
+
+    return true;
 }
 
 void
 SerServer::doSend(const string &packet)
 {
     transmittedBytes += (isize)packet.size();
-    connection.send(packet);
+    enqueue(packet);
+    flush();
     
     if (config.verbose) {
         retroShell << "T: " << util::makePrintable(packet) << "\n";
@@ -89,88 +123,255 @@ SerServer::doSend(const string &packet)
 void
 SerServer::doProcess(const string &packet)
 {
-    for (auto c : packet) { processIncomingByte((u8)c); }
+    // The bytes have already been handed over to the UART's ring buffer
+    if (config.verbose) {
+        retroShell << "R: " << util::makePrintable(packet) << "\n";
+    }
 }
 
 void
-SerServer::processIncomingByte(u8 byte)
+SerServer::didConnect()
 {
-    if (!buffer.isFull()) {
-
-        buffer.write(byte);
+    SUSPENDED
         
-        // When enough bytes have been received, leave buffering mode
-        if (buffer.count() >= 8) buffering = false;
+    // Start a new session
+    receivedBytes = 0;
+    transmittedBytes = 0;
+    processedBytes = 0;
+    lostBytes = 0;
+    output.clear();
+    lastOutputSize = 0;
+    
+    // Start scheduling messages
+    scheduleFirstEvent();
+}
 
-    } else {
+void
+SerServer::didDisconnect()
+{
+    SUSPENDED
 
-        lostBytes++;
-        debug(SRV_DEBUG, "Buffer overflow\n");
-    }
+    // Stop scheduling messages unless the pseudo terminal is in use
+    if (!hasPty()) scheduler.cancel <SLOT_SER> ();
 }
 
 void
-SerServer::didConnect()
+SerServer::openPty()
 {
+#ifdef _WIN32
+
+    throw VAError(ERROR_FILE_CANT_CREATE, "PTY");
+
+#else
+
+    if (hasPty()) return;
+
     SUSPENDED
-        
-    // Start a new sessing
-    skippedTransmissions = 0;
+
+    // Stop the TCP server
+    _stop();
+
+    // Create the pseudo terminal
+    auto fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (fd < 0) throw VAError(ERROR_FILE_CANT_CREATE, "PTY");
+
+    const char *name = nullptr;
+    if (grantpt(fd) != 0 || unlockpt(fd) != 0 || (name = ptsname(fd)) == nullptr) {
+
+        close(fd);
+        throw VAError(ERROR_FILE_CANT_CREATE, "PTY");
+    }
+
+    // Pass all bytes unaltered
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0) {
+
+        cfmakeraw(&tio);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    synchronized {
+
+        ptyName = name;
+        pty = fd;
+    }
+
+    // Start a new session
     receivedBytes = 0;
     transmittedBytes = 0;
     processedBytes = 0;
     lostBytes = 0;
-    
-    printf("Starting to schedule messages\n");
+    output.clear();
+    lastOutputSize = 0;
+
+    ptyQuit = false;
+    ptyThread = std::thread(&SerServer::ptyLoop, this);
+
+    retroShell << "Serial port connected to " << ptyName << '\n';
+
     // Start scheduling messages
-    assert(scheduler.id[SLOT_SER] == EVENT_NONE);
-    scheduler.scheduleImm <SLOT_SER> (SER_RECEIVE);
+    scheduleFirstEvent();
+
+#endif
 }
 
 void
-SerServer::didDisconnect()
+SerServer::closePty()
 {
+    if (!hasPty()) return;
+
     SUSPENDED
 
-    printf("STOPPING to schedule messages\n");
+    ptyQuit = true;
+    if (ptyThread.joinable()) ptyThread.join();
 
-    // Stop scheduling messages
-    scheduler.cancel <SLOT_SER> ();
+    synchronized {
+
+#ifndef _WIN32
+        close(pty.exchange(-1));
+#else
+        pty = -1;
+#endif
+        ptyName = "";
+    }
+    output.clear();
+
+    // Stop scheduling messages unless a TCP client is connected
+    if (!isConnected()) scheduler.cancel <SLOT_SER> ();
+}
+
+void
+SerServer::ptyLoop()
+{
+#ifndef _WIN32
+
+    u8 data[4096];
+
+    while (!ptyQuit) {
+
+        // Wait until the ring buffer has space again
+        auto space = std::min((isize)sizeof(data), buffer.free());
+        if (space == 0) {
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        struct pollfd fd = { pty, POLLIN, 0 };
+        if (poll(&fd, 1, 50) <= 0) continue;
+
+        if (fd.revents & POLLIN) {
+
+            auto count = read(pty, data, space);
+            if (count > 0) {
+
+                buffer.write(data, count);
+                receivedBytes += count;
+                continue;
+            }
+        }
+
+        // If no program has opened the slave device, try again later
+        if (fd.revents & (POLLHUP | POLLERR)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+    }
+
+#endif
+}
+
+void
+SerServer::transmit(u8 byte)
+{
+    if (isConnected() || hasPty()) output += (char)byte;
+}
+
+void
+SerServer::flushOutput()
+{
+    if (output.empty()) return;
+
+    if (hasPty()) {
+
+#ifndef _WIN32
+        auto count = write(pty, output.data(), output.size());
+        if (count > 0) {
+
+            if (config.verbose) {
+                retroShell << "T: " << util::makePrintable(output.substr(0, count)) << "\n";
+            }
+            transmittedBytes += count;
+            output.erase(0, count);
+        }
+#endif
+        // Drop the data if nobody reads from the slave device
+        if ((isize)output.size() > buffer.cap()) {
+
+            lostBytes += (isize)output.size();
+            output.clear();
+        }
+
+    } else {
+
+        send(output);
+        output.clear();
+    }
 }
 
 void
 SerServer::serviceSerEvent()
 {
     assert(scheduler.id[SLOT_SER] == SER_RECEIVE);
-    
-    if (buffer.isEmpty()) {
-        
-        // Enter buffering mode if we run dry
-        buffering = true;
 
-    } else if (buffering) {
-        
-        // Exit buffering mode if now new symbols came in for quite a while
-        if (++skippedTransmissions > 8) buffering = false;
+    bool received = false;
+
+    // Hand the oldest buffer element over to the UART
+    if (!buffer.isEmpty()) {
 
-    } else {
-    
-        // Hand the oldest buffer element over to the UART
         uart.receiveShiftReg = buffer.read();
         uart.copyFromReceiveShiftRegister();
         processedBytes++;
-        skippedTransmissions = 0;
+        received = true;
     }
-    
-    scheduleNextEvent();
+
+    // Transmit the outgoing bytes if the batch is full or the UART is idle
+    auto size = (isize)output.size();
+    if (size >= batchSize || (size && size == lastOutputSize)) flushOutput();
+    lastOutputSize = (isize)output.size();
+
+    scheduleNextEvent(received);
 }
 
 void
-SerServer::scheduleNextEvent()
+SerServer::scheduleFirstEvent()
+{
+    if (!scheduler.hasEvent<SLOT_SER>()) {
+        agnus.scheduleRel<SLOT_SER>(0, SER_RECEIVE);
+    }
+}
+
+void
+SerServer::scheduleNextEvent(bool received)
 {
     assert(scheduler.id[SLOT_SER] == SER_RECEIVE);
-    
-    // Otherwise, emulate proper timing based on the current baud rate
+
+    auto cycles = frameTime();
+
+    /* As long as bytes are streaming in, the next event is scheduled relative
+     * to the previous one. This prevents the delivery times from drifting
+     * if an event is serviced late.
+     */
+    if (received && agnus.clock - scheduler.trigger[SLOT_SER] < cycles) {
+        scheduler.scheduleInc<SLOT_SER>(cycles, SER_RECEIVE);
+    } else {
+        agnus.scheduleRel<SLOT_SER>(cycles, SER_RECEIVE);
+    }
+}
+
+Cycle
+SerServer::frameTime() const
+{
     auto pulseWidth = uart.pulseWidth();
     
     // If the pulseWidth is extremely low, fallback to a default value
@@ -179,6 +380,7 @@ SerServer::scheduleNextEvent()
         debug(SRV_DEBUG, "Very low SERPER value\n");
         pulseWidth = 12000;
     }
-    
-    agnus.scheduleRel<SLOT_SER>(8 * pulseWidth, SER_RECEIVE);
+
+    // A frame consists of a start bit, the data bits, and a stop bit
+    return (uart.packetLength() + 2) * pulseWidth;
 }
@@ -11,27 +11,47 @@
 
 #include "RemoteServer.h"
 #include "RingBuffer.h"
+#include <atomic>
+#include <thread>
 
+/* The serial server connects the UART with the outside world. Incoming bytes
+ * are written into a lock-free ring buffer by the I/O reactor of the remote
+ * manager or by the reader thread of the pseudo terminal. The emulator thread
+ * picks them up in the SER slot and hands them over to the UART with the
+ * timing implied by the SERPER register, i.e., a new byte is delivered each
+ * time a complete frame (start bit, data bits, stop bit) has been shifted in.
+ * Outgoing bytes are collected and sent in batches.
+ *
+ * Besides TCP, the server is able to use a pseudo terminal as transport
+ * layer. It is opened when the serial port device is set to SPD_PTY. Other
+ * programs can connect to the Amiga by opening the slave device whose name is
+ * printed in RetroShell.
+ */
 class SerServer : public RemoteServer {
-      
-    // A ringbuffer for buffering incoming bytes
-    util::SortedRingBuffer <u8, 8096> buffer;
-    
-    /* Indicates if we are currenty running in buffering mode. In this mode,
-     * incoming bytes are collected in the ring buffer withous passing them
-     * to the UART. When a certain number of bytes has been received, buffering
-     * mode is left and the collected symbols are fed into the UART with proper
-     * timing. Buffering mode is also left when no symbols were incoming for
-     * a longer period of time to prevent symbols from starving in the buffer
-     * at the end of a transmission.
+
+    // Incoming bytes waiting to be passed to the UART
+    util::ConcurrentRingBuffer <u8, 65536> buffer;
+
+    // Outgoing bytes waiting to be transmitted
+    string output;
+
+    // Size of the output buffer at the time of the latest SER event
+    isize lastOutputSize = 0;
+
+    // Maximum number of bytes collected before they are transmitted
+    static constexpr isize batchSize = 256;
+
+    /* The pseudo terminal (POSIX only). The file descriptor is atomic, because
+     * the reactor thread and the reader thread check it via hasPty() while the
+     * emulator thread opens or closes the terminal.
      */
-    bool buffering = true;
-        
-    // Used to determine when we need to leave buffering mode
-    i64 skippedTransmissions = 0;
-    
+    std::atomic<int> pty = -1;
+    string ptyName;
+    std::thread ptyThread;
+    std::atomic<bool> ptyQuit = false;
+
     // Byte counters
-    isize receivedBytes = 0;
+    std::atomic<isize> receivedBytes = 0;
     isize transmittedBytes = 0;
     isize processedBytes = 0;
     isize lostBytes = 0;
@@ -40,6 +60,7 @@ class SerServer : public RemoteServer {
 public:
     
     SerServer(Amiga& ref);
+    ~SerServer();
     
 
     //
@@ -60,13 +81,49 @@ public:
     
     ServerConfig getDefaultConfig() override;
     bool shouldRun() override;
-    string doReceive() override;
+    bool canReceive(const Client &client) const override;
+    bool doReceive(Client &client, string &packet) override;
     void doSend(const string &packet) override;
     void doProcess(const string &packet) override;
     void didConnect() override;
     void didDisconnect() override;
 
-    void processIncomingByte(u8 byte);
+
+    //
+    // Using a pseudo terminal
+    //
+
+public:
+
+    // Checks if a pseudo terminal is used as transport layer
+    bool hasPty() const { return pty >= 0; }
+
+    // Returns the name of the slave device
+    const string &getPtyName() const { return ptyName; }
+
+    // Opens or closes the pseudo terminal
+    void openPty() throws;
+    void closePty();
+
+private:
+
+    // Main loop of the reader thread
+    void ptyLoop();
+
+    
+    //
+    // Transmitting bytes
+    //
+
+public:
+
+    // Called by the UART for each outgoing byte
+    void transmit(u8 byte);
+
+private:
+
+    // Sends all collected bytes
+    void flushOutput();
 
     
     //
@@ -78,6 +135,14 @@ public:
     // Services an event in the SER slot
     void serviceSerEvent();
     
+    // Schedules the first event in the SER slot if no event is pending
+    void scheduleFirstEvent();
+
+private:
+
     // Schedules the next event in the SER slot
-    void scheduleNextEvent();    
+    void scheduleNextEvent(bool received);
+
+    // Returns the number of cycles needed to transfer a single frame
+    Cycle frameTime() const;
 };
@@ -10,6 +10,25 @@
 #include "config.h"
 #include "Socket.h"
 #include "MemUtils.h"
+#include <mutex>
+
+#ifndef _WIN32
+#include <cerrno>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+// Checks if the latest socket operation failed because it would block
+static bool wouldBlock()
+{
+#ifdef _WIN32
+    return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+    return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+#endif
+}
 
 Socket::Socket() : socket(INVALID_SOCKET)
 {
@@ -24,6 +43,7 @@ Socket::Socket(SOCKET id) : socket(id)
 Socket::Socket(Socket&& other)
 {
     socket = other.socket;
+    outbuf = std::move(other.outbuf);
     other.socket = INVALID_SOCKET;
 }
 
@@ -35,6 +55,7 @@ Socket& Socket::operator=(Socket&& other)
 
         close();
         socket = other.socket;
+        outbuf = std::move(other.outbuf);
         other.socket = INVALID_SOCKET;        
     }
     return *this;
@@ -90,6 +111,18 @@ void Socket::create()
     }
 }
 
+void
+Socket::setBlocking(bool value)
+{
+#ifdef _WIN32
+    u_long mode = value ? 0 : 1;
+    ioctlsocket(socket, FIONBIO, &mode);
+#else
+    auto flags = fcntl(socket, F_GETFL, 0);
+    fcntl(socket, F_SETFL, value ? flags & ~O_NONBLOCK : flags | O_NONBLOCK);
+#endif
+}
+
 void
 Socket::connect(u16 port)
 {
@@ -147,12 +180,18 @@ Socket::accept()
 std::string
 Socket::recv()
 {    
-    char buffer[BUFFER_SIZE + 1] = {};
-    if (auto n = ::recv(socket, buffer, BUFFER_SIZE, 0); n > 0) {
+    char buffer[BUFFER_SIZE];
+    auto n = ::recv(socket, buffer, BUFFER_SIZE, 0);
+
+    if (n > 0) {
         
         // Convert the buffer to a string
-        string result = string(buffer, n);
-        return result;
+        return string(buffer, n);
+    }
+    if (n < 0 && wouldBlock()) {
+
+        // No data available yet (non-blocking mode)
+        return "";
     }
     
     throw VAError(ERROR_SOCK_CANT_RECEIVE);
@@ -161,17 +200,47 @@ Socket::recv()
 void
 Socket::send(u8 value)
 {
-    if (::send(socket, (const char *)&value, 1, 0) < 1) {
-        throw VAError(ERROR_SOCK_CANT_SEND);
-    }
+    std::lock_guard<util::Mutex> guard(outMutex);
+    outbuf += (char)value;
 }
 
 void
 Socket::send(const string &s)
 {
-    if (::send(socket, s.c_str(), (int)s.length(), 0) < 0) {
-        throw VAError(ERROR_SOCK_CANT_SEND);
+    std::lock_guard<util::Mutex> guard(outMutex);
+    outbuf += s;
+}
+
+bool
+Socket::hasPendingData()
+{
+    std::lock_guard<util::Mutex> guard(outMutex);
+    return !outbuf.empty();
+}
+
+bool
+Socket::flush()
+{
+    std::lock_guard<util::Mutex> guard(outMutex);
+
+    // Send the buffered data, which may take more than one call
+    isize sent = 0;
+    while (sent < (isize)outbuf.size()) {
+
+        auto n = ::send(socket, outbuf.data() + sent,
+                        (int)(outbuf.size() - sent), MSG_NOSIGNAL);
+        if (n <= 0) {
+
+            // Keep the remaining data if the socket is in non-blocking mode
+            if (n < 0 && wouldBlock()) break;
+
+            outbuf.clear();
+            throw VAError(ERROR_SOCK_CANT_SEND);
+        }
+        sent += n;
     }
+    outbuf.erase(0, sent);
+    return outbuf.empty();
 }
 
 void
@@ -187,4 +256,7 @@ Socket::close()
 #endif
         socket = INVALID_SOCKET;
     }
+
+    std::lock_guard<util::Mutex> guard(outMutex);
+    outbuf.clear();
 }
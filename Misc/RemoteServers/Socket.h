@@ -10,6 +10,7 @@
 #pragma once
 
 #include "AmigaObject.h"
+#include "Concurrency.h"
 
 #ifdef _WIN32
 
@@ -23,6 +24,8 @@
 
 #include <sys/socket.h>
 #include <arpa/inet.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <unistd.h>
 
 typedef int SOCKET;
@@ -34,10 +37,14 @@ class Socket : public AmigaObject {
 
     SOCKET socket;
 
+    // Outgoing data waiting to be transmitted
+    string outbuf;
+    util::Mutex outMutex;
+
 public:
     
     // Size of the communication buffer
-    static constexpr isize BUFFER_SIZE = 512;
+    static constexpr isize BUFFER_SIZE = 4096;
     
     
     //
@@ -55,6 +62,13 @@ public:
     ~Socket();
 
     void create();
+
+    // Returns the socket descriptor
+    SOCKET getId() const { return socket; }
+    bool isOpen() const { return socket != INVALID_SOCKET; }
+
+    // Switches between blocking and non-blocking mode
+    void setBlocking(bool value);
         
     
     //
@@ -86,8 +100,20 @@ public:
     
 public:
     
-    string recv();
+    // Receives data (returns an empty string if a non-blocking read would block)
+    string recv() throws;
+
+    // Adds data to the output buffer
     void send(u8 value);
     void send(char c) { send((u8)c); }
     void send(const string &s);
+
+    // Checks if the output buffer contains data
+    bool hasPendingData();
+
+    /* Transmits the buffered data. In non-blocking mode, the function returns
+     * as soon as the socket would block. It returns true if the output buffer
+     * has been drained.
+     */
+    bool flush() throws;
 };
@@ -213,6 +213,10 @@ public:
 
     // Transfers a DMA request to Agnus (done in the first refresh cycle)
     void requestDMA() { if (audDR) { agnus.setAudxDR<nr>(); audDR = 0; } }
+
+    // Called at the end of each rasterline
+    bool hsyncIdle() const { return !audDR; }
+    void hsyncHandler() { requestDMA(); }
     
     
     //
@@ -248,4 +248,10 @@ public:
 
     // Charges or discharges a potentiometer capacitor
     void servicePotEvent(EventID id);
+
+    // Updates the pot counters at the end of each rasterline
+    bool hsyncIdle() const {
+        return chargeX0 >= 1.0 && chargeY0 >= 1.0 && chargeX1 >= 1.0 && chargeY1 >= 1.0;
+    }
+    void hsyncHandler();
 };
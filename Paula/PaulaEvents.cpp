@@ -123,3 +123,13 @@ Paula::servicePotEvent(EventID id)
             fatalError;
     }
 }
+
+void
+Paula::hsyncHandler()
+{
+    // Update pot counters
+    potCntX0 += chargeX0 < 1.0;
+    potCntY0 += chargeY0 < 1.0;
+    potCntX1 += chargeX1 < 1.0;
+    potCntY1 += chargeY1 < 1.0;
+}
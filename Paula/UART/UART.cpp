@@ -104,7 +104,7 @@ UART::copyToTransmitShiftRegister()
 
     // Send the byte to the null modem cable
     auto byte = (char)(transmitBuffer & 0xFF);
-    remoteManager.serServer << byte;
+    remoteManager.serServer.transmit((u8)byte);
     
     // Inform the GUI about the outgoing data
     msgQueue.put(MSG_SER_OUT, transmitBuffer);
@@ -9,6 +9,7 @@
 
 #include "config.h"
 #include "Disk.h"
+#include "ADFFile.h"
 #include "DiskFile.h"
 
 void
@@ -36,6 +37,8 @@ Disk::init(const class DiskFile &file)
 {
     init(file.getDiskDiameter(), file.getDiskDensity());
     encodeDisk(file);
+
+    if (auto adf = file.getEncoderADF()) fnv = adf->fnv();
 }
 
 void
@@ -224,7 +227,7 @@ Disk::decodeMFM(u8 *dst, u8 *src, isize count)
 }
 
 void
-Disk::encodeOddEven(u8 *dst, u8 *src, isize count)
+Disk::encodeOddEven(u8 *dst, const u8 *src, isize count)
 {
     // Encode odd bits
     for(isize i = 0; i < count; i++)
@@ -276,6 +279,9 @@ Disk::addClockBits(u8 value, u8 previous)
 void
 Disk::repeatTracks()
 {
+    // Shared disks have been prepared before entering the image cache
+    if (shared) return;
+
     for (Track t = 0; t < 168; t++) {
         
         isize end = length.track[t];
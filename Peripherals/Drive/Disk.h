@@ -53,6 +53,7 @@ class Disk : public AmigaObject {
     friend class ADFFile;
     friend class EXTFile;
     friend class IMGFile;
+    friend class ImageCache;
     
 public:
     
@@ -86,6 +87,9 @@ private:
     
     // Checksum of this disk if it was created from an ADF file, 0 otherwise
     u64 fnv = 0;
+
+    // Indicates if this disk is shared via the image cache (read-only)
+    bool shared = false;
     
     
     //
@@ -158,6 +162,8 @@ public:
     void setModified(bool value) { modified = value; }
     
     u64 getFnv() const { return fnv; }
+
+    bool isShared() const { return shared; }
     
 
     //
@@ -207,7 +213,7 @@ public:
     static void encodeMFM(u8 *dst, u8 *src, isize count);
     static void decodeMFM(u8 *dst, u8 *src, isize count);
 
-    static void encodeOddEven(u8 *dst, u8 *src, isize count);
+    static void encodeOddEven(u8 *dst, const u8 *src, isize count);
     static void decodeOddEven(u8 *dst, u8 *src, isize count);
 
     static void addClockBits(u8 *dst, isize count);
@@ -14,6 +14,7 @@
 #include "CIA.h"
 #include "DiskFile.h"
 #include "FSDevice.h"
+#include "ImageCache.h"
 #include "MsgQueue.h"
 
 Drive::Drive(Amiga& ref, isize n) : SubComponent(ref), nr(n)
@@ -538,6 +539,8 @@ void
 Drive::writeByte(u8 value)
 {
     if (disk) {
+
+        if (disk->isShared()) unshareDisk();
         disk->writeByte(value, head.cylinder, head.side, head.offset);
     }
 }
@@ -699,11 +702,13 @@ Drive::setWriteProtection(bool value)
         
         if (value && !disk->isWriteProtected()) {
             
+            unshareDisk();
             disk->setWriteProtection(true);
             msgQueue.put(MSG_DISK_PROTECT);
         }
         if (!value && disk->isWriteProtected()) {
             
+            unshareDisk();
             disk->setWriteProtection(false);
             msgQueue.put(MSG_DISK_UNPROTECT);
         }
@@ -714,10 +719,34 @@ void
 Drive::toggleWriteProtection()
 {
     if (hasDisk()) {
+
+        unshareDisk();
         disk->setWriteProtection(!disk->isWriteProtected());
     }
 }
 
+void
+Drive::setModifiedDisk(bool value)
+{
+    if (disk && disk->isModified() != value) {
+
+        unshareDisk();
+        disk->setModified(value);
+    }
+}
+
+void
+Drive::unshareDisk()
+{
+    if (disk && disk->isShared()) {
+
+        debug(DSK_DEBUG, "Creating a private copy of a shared disk\n");
+
+        disk = std::make_shared<Disk>(*disk);
+        disk->shared = false;
+    }
+}
+
 bool
 Drive::isInsertable(DiskDiameter t, DiskDensity d) const
 {
@@ -779,7 +808,7 @@ Drive::ejectDisk(Cycle delay)
 }
 
 template <EventSlot s> void
-Drive::insertDisk(std::unique_ptr<Disk> disk, Cycle delay)
+Drive::insertDisk(std::shared_ptr<Disk> disk, Cycle delay)
 {
     assert(disk != nullptr);
     
@@ -802,7 +831,7 @@ Drive::insertDisk(std::unique_ptr<Disk> disk, Cycle delay)
 }
 
 void
-Drive::insertDisk(std::unique_ptr<Disk> disk, Cycle delay)
+Drive::insertDisk(std::shared_ptr<Disk> disk, Cycle delay)
 {
     debug(DSK_DEBUG, "insertDisk(%lld)\n", delay);
     
@@ -833,7 +862,7 @@ Drive::insertNew()
 }
 
 void
-Drive::swapDisk(std::unique_ptr<Disk> disk)
+Drive::swapDisk(std::shared_ptr<Disk> disk)
 {
     debug(DSK_DEBUG, "swapDisk()\n");
     
@@ -864,7 +893,7 @@ Drive::swapDisk(std::unique_ptr<Disk> disk)
 void
 Drive::swapDisk(class DiskFile &file)
 {
-    swapDisk(std::make_unique<Disk>(file));
+    swapDisk(ImageCache::disk(file));
 }
 
 void
@@ -72,13 +72,16 @@ class Drive : public SubComponent {
 
 public:
     
-    // The currently inserted disk (if any)
-    std::unique_ptr<Disk> disk;
+    /* The currently inserted disk (if any). The disk may be shared with other
+     * drives via the image cache. In this case, it is replaced by a private
+     * copy before it gets modified.
+     */
+    std::shared_ptr<Disk> disk;
 
 private:
 
     // A disk waiting to be inserted (if any)
-    std::unique_ptr<Disk> diskToInsert;
+    std::shared_ptr<Disk> diskToInsert;
     
     // Search path for disk files, one for each drive
     string searchPath;
@@ -275,7 +278,7 @@ public:
     bool hasDDDisk() const { return disk ? disk->density == DISK_DD : false; }
     bool hasHDDisk() const { return disk ? disk->density == DISK_HD : false; }
     bool hasModifiedDisk() const { return disk ? disk->isModified() : false; }
-    void setModifiedDisk(bool value) { if (disk) disk->setModified(value); }
+    void setModifiedDisk(bool value);
     
     bool hasWriteEnabledDisk() const;
     bool hasWriteProtectedDisk() const;
@@ -292,10 +295,10 @@ public:
     void ejectDisk(Cycle delay = 0);
     
     // Inserts a new disk with an optional delay
-    void insertDisk(std::unique_ptr<Disk> disk, Cycle delay = 0) throws;
+    void insertDisk(std::shared_ptr<Disk> disk, Cycle delay = 0) throws;
     
     // Replaces the current disk (recommended way to insert disks)
-    void swapDisk(std::unique_ptr<Disk> disk) throws;
+    void swapDisk(std::shared_ptr<Disk> disk) throws;
     void swapDisk(class DiskFile &file) throws;
     void swapDisk(const string &name) throws;
 
@@ -306,7 +309,10 @@ public:
 private:
     
     template <EventSlot s> void ejectDisk(Cycle delay);
-    template <EventSlot s> void insertDisk(std::unique_ptr<Disk> disk, Cycle delay) throws;
+    template <EventSlot s> void insertDisk(std::shared_ptr<Disk> disk, Cycle delay) throws;
+
+    // Replaces a shared disk by a private copy
+    void unshareDisk();
 
     
     //
@@ -232,7 +232,7 @@ void
 Joystick::vsyncHandler()
 {
     // Only proceed if auto fire is enabled
-    if (!config.autofire || config.autofireDelay < 0) return;
+    if (vsyncIdle()) return;
   
     // Only proceed if a trigger frame has been reached
     if (agnus.frame.nr != nextAutofireFrame) return;
@@ -115,6 +115,7 @@ public:
     void trigger(GamePadAction event);
 
     // To be called after each frame
+    bool vsyncIdle() const { return !config.autofire || config.autofireDelay < 0; }
     void vsyncHandler();
     
 private:
@@ -101,25 +101,18 @@ Interpreter::exec(const string& userInput, bool verbose)
     exec(tokens, verbose);
 }
 
-void
-Interpreter::exec(const Arguments &argv, bool verbose)
+Command *
+Interpreter::resolve(const Arguments &argv, Arguments &args, bool &configures)
 {
-    // In 'verbose' mode, print the token list
-    if (verbose) {
-        for (const auto &it : argv) retroShell << it << ' ';
-        retroShell << '\n';
-    }
-    
-    // Skip empty lines
-    if (argv.empty()) return;
-    
     // Seek the command in the command tree
     Command *current = &root, *next;
-    Arguments args = argv;
+    args = argv;
+    configures = false;
 
     while (!args.empty() && ((next = current->seek(args.front())) != nullptr)) {
         
-        current = current->seek(args.front());
+        if (next->token == "set") configures = true;
+        current = next;
         args.erase(args.begin());
     }
                 
@@ -134,11 +127,97 @@ Interpreter::exec(const Arguments &argv, bool verbose)
     // Check the argument count
     if ((isize)args.size() < current->minArgs) throw TooFewArgumentsError(current->tokens());
     if ((isize)args.size() > current->maxArgs) throw TooManyArgumentsError(current->tokens());
+
+    return current;
+}
+
+void
+Interpreter::exec(const Arguments &argv, bool verbose)
+{
+    // In 'verbose' mode, print the token list
+    if (verbose) {
+        for (const auto &it : argv) retroShell << it << ' ';
+        retroShell << '\n';
+    }
+    
+    // Skip empty lines
+    if (argv.empty()) return;
+    
+    // Seek the command handler
+    Arguments args;
+    bool configures;
+    auto current = resolve(argv, args, configures);
     
     // Call the command handler
     (retroShell.*(current->action))(args, current->param);
 }
 
+void
+Interpreter::exec(const CompiledCommand &command)
+{
+    // Report errors that were detected while parsing
+    if (command.error) std::rethrow_exception(command.error);
+
+    // Skip empty lines and comments
+    if (command.command == nullptr) return;
+
+    // Call the command handler
+    Arguments args = command.args;
+    (retroShell.*(command.command->action))(args, command.command->param);
+}
+
+CompiledCommand
+Interpreter::compile(const string& userInput)
+{
+    CompiledCommand result;
+    result.source = userInput;
+
+    // Skip comments
+    if (userInput[0] == '#') return result;
+
+    // Check if the command is marked with 'try'
+    result.ignoreError = userInput.rfind("try", 0) == 0;
+
+    try {
+
+        // Split the command string
+        Arguments tokens = split(userInput);
+
+        // Skip empty lines
+        if (tokens.empty()) return result;
+
+        // Remove the 'try' keyword
+        if (tokens.front() == "try") tokens.erase(tokens.begin());
+
+        // Auto complete the token list
+        autoComplete(tokens);
+
+        // Seek the command handler
+        if (!tokens.empty()) {
+            result.command = resolve(tokens, result.args, result.configures);
+        }
+
+    } catch (...) {
+
+        // Keep the error until the command gets executed
+        result.error = std::current_exception();
+    }
+
+    return result;
+}
+
+CompiledScript
+Interpreter::compileScript(const string& contents)
+{
+    CompiledScript result;
+
+    std::stringstream ss(contents);
+    string line;
+    while (std::getline(ss, line)) result.push_back(compile(line));
+
+    return result;
+}
+
 void
 Interpreter::usage(const Command& current)
 {
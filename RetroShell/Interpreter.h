@@ -14,26 +14,28 @@
 #include "Exception.h"
 #include "Error.h"
 #include "Parser.h"
+#include <exception>
 
 enum class Token
 {
-    about, accuracy, agnus, amiga, attach, audiate, audio, autosync, bankmap,
+    about, accuracy, agnus, amiga, attach, audiate, audio, autosync, bankmap, benchmark,
     bitplanes, blitter, brightness, channel, checksums, chip, cia, clear, close,
     clxsprspr, clxsprplf, clxplfplf, color, config, connect, contrast,
-    controlport, copper, cpu, cutout, dc, debug, defaultbb, defaultfs, delay,
+    controlport, convert, copper, cpu, cutout, dc, debug, defaultbb, defaultfs, delay,
     denise, detach, device, devices, dfn, disable, disconnect, disk, dma,
     dmadebugger, dsksync, easteregg, eject, enable, esync, events, execbase,
-    extrom, extstart, fast, filename, filter, gdb, help, hide, init, info,
+    extrom, extstart, fast, filename, filter, format, frameskip, gdb, help, hide, init, info,
     insert, inspect, interrupts, joystick, jump, keyboard, keyset, layers, left,
     library, libraries, list, load, lock,mechanics, memory, mode, model,
     monitor, mouse, none, off, on, opacity, open, os, palette, pan, path,
     paula, pause, poll, port, ports, power, press, process, processes, pullup,
-    raminitpattern, refresh, registers, regreset, regression, reset, resource,
-    resources, revision, right, rom, rshell, rtc, run, sampling, saturation,
+    raminitpattern, record, refresh, registers, regreset, regression, renderthread,
+    reset, resource, resources, revision, right, rom, rshell, rtc, run,
+    sampling, saturation,
     save, saveroms, screenshot, searchpath, serial, server, set, setup,
-    shakedetector, show, slow, slowramdelay,slowrammirror, source, speed,
-    sprites, start, state, status, step, stop, swapdelay, task, tasks, tod,
-    todbug, unmappingtype, verbose, velocity, volume, wait, wom
+    shakedetector, show, skipinterval, slow, slowramdelay,slowrammirror, source, speed,
+    sprites, sse, start, state, status, step, stop, swapdelay, task, tasks, tod,
+    todbug, trace, unmappingtype, verbose, velocity, volume, wait, warpskip, wom
 };
 
 struct TooFewArgumentsError : public util::ParseError {
@@ -48,6 +50,31 @@ struct ScriptInterruption: util::Exception {
     using Exception::Exception;
 };
 
+/* A command that has been parsed in advance. Scripts are translated into a
+ * list of such commands before they are executed. Hence, each line is split,
+ * auto-completed, and looked up in the command tree only once.
+ */
+struct CompiledCommand {
+
+    // The original command string
+    string source;
+
+    // The command handler and the arguments passed to it
+    Command *command = nullptr;
+    Arguments args;
+
+    // Indicates if errors should be ignored (command is prefixed with 'try')
+    bool ignoreError = false;
+
+    // Indicates if the command changes the emulator configuration
+    bool configures = false;
+
+    // Error detected while parsing (thrown when the command is executed)
+    std::exception_ptr error;
+};
+
+typedef std::vector<CompiledCommand> CompiledScript;
+
 class Interpreter: SubComponent
 {
     // The registered instruction set
@@ -115,6 +142,25 @@ private:
     // Auto-completes an argument list
     void autoComplete(Arguments &argv);
 
+    /* Seeks the command handler for an argument list. On success, the
+     * function returns the handler node and the remaining arguments. The
+     * 'configures' flag is set if the command path contains a 'set' token.
+     */
+    Command *resolve(const Arguments &argv, Arguments &args, bool &configures) throws;
+
+    
+    //
+    // Compiling commands
+    //
+
+public:
+
+    // Parses a single command
+    CompiledCommand compile(const string& userInput);
+
+    // Parses all lines of a script
+    CompiledScript compileScript(const string& contents);
+
     
     //
     // Executing commands
@@ -125,6 +171,7 @@ public:
     // Executes a single command
     void exec(const string& userInput, bool verbose = false) throws;
     void exec(const Arguments &argv, bool verbose = false) throws;
+    void exec(const CompiledCommand &command) throws;
             
     // Prints a usage string for a command
     void usage(const Command &command);
@@ -46,6 +46,10 @@ Interpreter::registerInstructions()
              "command", "Pauses the execution of a command script",
              &RetroShell::exec <Token::wait>, 2);
 
+    root.add({"convert"},
+             "command", "Converts a disk file or a directory of disk files",
+             &RetroShell::exec <Token::convert>, 3);
+
     
     //
     // Regression testing
@@ -62,6 +66,14 @@ Interpreter::registerInstructions()
     root.add({"regression", "run"},
              "command", "Launches a regression test",
              &RetroShell::exec <Token::regression, Token::run>, 1);
+
+    root.add({"regression", "benchmark"},
+             "command", "Measures the time spent in the line hooks",
+             &RetroShell::exec <Token::regression, Token::benchmark>, 0);
+
+    root.add({"regression", "sse"},
+             "command", "Compares the SSE drawing code with the scalar code",
+             &RetroShell::exec <Token::regression, Token::sse>, 0);
     
     root.add({"screenshot"},
              "component", "Manages regression tests");
@@ -243,6 +255,17 @@ Interpreter::registerInstructions()
              "command", "Jumps to the specified address",
              &RetroShell::exec <Token::cpu, Token::jump>, 1);
 
+    root.add({"cpu", "trace"},
+             "command", "Records all executed instructions in a trace file");
+
+    root.add({"cpu", "trace", "start"},
+             "key", "Starts recording into the specified file",
+             &RetroShell::exec <Token::cpu, Token::trace, Token::start>, 1);
+
+    root.add({"cpu", "trace", "stop"},
+             "command", "Stops recording and closes the trace file",
+             &RetroShell::exec <Token::cpu, Token::trace, Token::stop>, 0);
+
     
     //
     // CIA
@@ -418,6 +441,18 @@ Interpreter::registerInstructions()
     root.add({"denise", "set", "clxplfplf"},
              "key", "Enables or disables playfield-playfield collision detection",
              &RetroShell::exec <Token::denise, Token::set, Token::clxplfplf>, 1);
+
+    root.add({"denise", "set", "frameskip"},
+             "key", "Sets the number of skipped frames per skip interval",
+             &RetroShell::exec <Token::denise, Token::set, Token::frameskip>, 1);
+
+    root.add({"denise", "set", "skipinterval"},
+             "key", "Sets the length of the skip interval in frames",
+             &RetroShell::exec <Token::denise, Token::set, Token::skipinterval>, 1);
+
+    root.add({"denise", "set", "warpskip"},
+             "key", "Enables or disables rendering in warp mode",
+             &RetroShell::exec <Token::denise, Token::set, Token::warpskip>, 1);
     
     root.add({"denise", "hide"},
              "command", "Hides bitplanes, sprites, or layers");
@@ -531,6 +566,21 @@ Interpreter::registerInstructions()
              "command", "Hides memory refresh cycles",
              &RetroShell::exec <Token::dmadebugger, Token::hide, Token::refresh>, 0);
 
+    root.add({"dmadebugger", "record"},
+             "command", "Records the bus usage of each rasterline");
+
+    root.add({"dmadebugger", "record", "start"},
+             "command", "Starts recording",
+             &RetroShell::exec <Token::dmadebugger, Token::record, Token::start>, 0);
+
+    root.add({"dmadebugger", "record", "stop"},
+             "command", "Stops recording",
+             &RetroShell::exec <Token::dmadebugger, Token::record, Token::stop>, 0);
+
+    root.add({"dmadebugger", "record", "save"},
+             "key", "Saves the most recently recorded frame",
+             &RetroShell::exec <Token::dmadebugger, Token::record, Token::save>, 1);
+
     
     //
     // Monitor
@@ -558,6 +608,14 @@ Interpreter::registerInstructions()
              "key", "Adjusts the saturation of the Amiga texture",
              &RetroShell::exec <Token::monitor, Token::set, Token::saturation>, 1);
 
+    root.add({"monitor", "set", "format"},
+             "key", "Selects the frame buffer format",
+             &RetroShell::exec <Token::monitor, Token::set, Token::format>, 1);
+
+    root.add({"monitor", "set", "renderthread"},
+             "key", "Colorizes rasterlines on a separate thread",
+             &RetroShell::exec <Token::monitor, Token::set, Token::renderthread>, 1);
+
     
     //
     // Audio
@@ -59,18 +59,18 @@ RetroShell::operator<<(long value)
 RetroShell&
 RetroShell::operator<<(std::stringstream &stream)
 {
-    string line;
-    while(std::getline(stream, line)) {
-        *this << line << '\n';
-    }
+    // Pass the whole text to the text storage and the remote shell at once
+    auto text = stream.str();
+    if (!text.empty() && text.back() != '\n') text += '\n';
+    *this << text;
     return *this;
 }
 
 const char *
 RetroShell::text()
 {
-    static string all;
-    
+    isDirty = false;
+
     // Add the storage contents
     storage.text(all);
         
@@ -80,6 +80,14 @@ RetroShell::text()
     return all.c_str();
 }
 
+TextStorage::Delta
+RetroShell::delta(i64 version)
+{
+    isDirty = false;
+
+    return storage.delta(version);
+}
+
 void
 RetroShell::tab(isize pos)
 {
@@ -97,7 +105,8 @@ RetroShell::tab(isize pos)
 void
 RetroShell::needsDisplay()
 {
-    msgQueue.put(MSG_UPDATE_CONSOLE);
+    // Only inform the GUI if it has processed the previous update
+    if (!isDirty.exchange(true)) msgQueue.put(MSG_UPDATE_CONSOLE);
 }
 
 void
@@ -291,14 +300,16 @@ RetroShell::execUserCommand(const string &command)
 void
 RetroShell::exec(const string &command)
 {
-    bool ignoreError = false;
-    
-    // Skip comments
-    if (command[0] == '#') return;
-    
+    exec(interpreter.compile(command));
+}
+
+void
+RetroShell::exec(const CompiledCommand &command)
+{
+    // The command might be deleted if it runs a new script
+    auto ignoreError = command.ignoreError;
+
     try {
-        // Check if the command marked with 'try'
-        ignoreError = command.rfind("try", 0) == 0;
         
         // Call the interpreter
         interpreter.exec(command);
@@ -316,37 +327,53 @@ RetroShell::exec(const string &command)
 void
 RetroShell::execScript(std::ifstream &fs)
 {
-    script.str("");
-    script << fs.rdbuf();
-    scriptLine = 1;
-    continueScript();
+    std::stringstream ss;
+    ss << fs.rdbuf();
+    execScript(ss.str());
 }
 
 void
 RetroShell::execScript(const string &contents)
 {
-    script.str("");
-    script << contents;
+    // Parse the script unless it has been parsed before
+    if (contents != scriptSource || script.empty()) {
+
+        script = interpreter.compileScript(contents);
+        scriptSource = contents;
+    }
     scriptLine = 1;
+    scriptCount++;
     continueScript();
 }
 
 void
 RetroShell::continueScript()
 {
-    string command;
-    while(std::getline(script, command)) {
-            
-        // Print the command
-        *this << command << '\n';
-        
-        // Execute the command
+    auto count = scriptCount;
+
+    while (scriptLine <= (isize)script.size()) {
+
         try {
-            exec(command);
-            
+
+            // Check if a sequence of configuration commands follows
+            isize last = scriptLine;
+            while (last <= (isize)script.size() && script[last - 1].configures) last++;
+
+            if (last - scriptLine > 1) {
+
+                // Apply all configuration changes under a single suspension
+                SUSPENDED
+
+                while (scriptLine < last && count == scriptCount) execScriptLine();
+
+            } else {
+
+                execScriptLine();
+            }
+
         } catch (ScriptInterruption &) {
             
-            msgQueue.put(MSG_SCRIPT_PAUSE, scriptLine);
+            msgQueue.put(MSG_SCRIPT_PAUSE, scriptLine++);
             return;
         
         } catch (std::exception &) {
@@ -356,12 +383,29 @@ RetroShell::continueScript()
             return;
         }
 
-        scriptLine++;
+        // Stop if the command has launched another script
+        if (count != scriptCount) return;
     }
     
     msgQueue.put(MSG_SCRIPT_DONE, scriptLine);
 }
 
+void
+RetroShell::execScriptLine()
+{
+    auto &command = script[scriptLine - 1];
+    auto count = scriptCount;
+
+    // Print the command
+    *this << command.source << '\n';
+
+    // Execute the command
+    exec(command);
+
+    // Advance to the next line unless the command has launched another script
+    if (count == scriptCount) scriptLine++;
+}
+
 void
 RetroShell::describe(const std::exception &e)
 {
@@ -425,14 +469,14 @@ RetroShell::help(const string &command)
 void
 RetroShell::dump(AmigaComponent &component, dump::Category category)
 {
-    std::stringstream ss; string line;
+    std::stringstream ss;
     
     { SUSPENDED
         
         component.dump(category, ss);
     }
     
-    while(std::getline(ss, line)) *this << line << '\n';
+    *this << ss;
 }
 
 void
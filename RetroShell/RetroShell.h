@@ -14,6 +14,7 @@
 #include "Interpreter.h"
 #include "TextStorage.h"
 
+#include <atomic>
 #include <sstream>
 #include <fstream>
 
@@ -36,8 +37,14 @@ class RetroShell : public SubComponent {
     // The currently active input string
     isize ipos = 0;
         
-    // Indicates if the the GUI needs a refresh
-    // [[deprecated]] bool isDirty = false;
+    /* Indicates if the GUI has been asked for a refresh. The flag is cleared
+     * when the GUI reads the text storage. As long as it is set, no further
+     * update messages are sent.
+     */
+    std::atomic<bool> isDirty = false;
+
+    // The text returned by text()
+    string all;
     
     
     //
@@ -62,11 +69,17 @@ class RetroShell : public SubComponent {
     //
     
     // The currently processed script
-    std::stringstream script;
-    
+    CompiledScript script;
+
+    // The source code of the currently processed script
+    string scriptSource;
+
     // The script line counter (first line = 1)
     isize scriptLine = 0;
 
+    // Incremented whenever a new script is launched
+    isize scriptCount = 0;
+
     // Wake up cycle for interrupted scripts
     Cycle wakeUp = INT64_MAX;
 
@@ -113,8 +126,17 @@ public:
     // Returns the prompt
     string getPrompt() { return prompt; }
     
+    // Returns the current input line
+    const string &getInput() { return input; }
+
     // Returns the contents of the whole storage as a single C string
     const char *text();
+
+    // Returns the version of the text storage
+    i64 getVersion() const { return storage.getVersion(); }
+
+    // Returns all lines that have changed since a certain version
+    TextStorage::Delta delta(i64 version);
         
     // Moves the cursor forward to a certain column
     void tab(isize pos);
@@ -177,6 +199,7 @@ public:
 
     // Executes a command
     void exec(const string &command) throws;
+    void exec(const CompiledCommand &command) throws;
 
     // Executes a shell script
     void execScript(std::ifstream &fs) throws;
@@ -187,6 +210,9 @@ public:
 
 private:
 
+    // Executes the current script line and advances the line counter
+    void execScriptLine() throws;
+
     // Prints a textual description of an error in the console
     void describe(const std::exception &exception);
 
@@ -11,6 +11,7 @@
 #include "RetroShell.h"
 #include "Amiga.h"
 #include "BootBlockImage.h"
+#include "DiskConverter.h"
 #include "FSTypes.h"
 #include "IOUtils.h"
 #include "Parser.h"
@@ -67,6 +68,40 @@ RetroShell::exec <Token::wait> (Arguments &argv, long param)
     throw ScriptInterruption("");
 }
 
+template <> void
+RetroShell::exec <Token::convert> (Arguments &argv, long param)
+{
+    auto format = FileType(util::parseEnum <FileTypeEnum> (argv[0]));
+    auto source = argv[1];
+    auto target = argv[2];
+    
+    if (!DiskConverter::isSupportedFormat(format)) {
+        throw VAError(ERROR_FILE_TYPE_UNSUPPORTED, argv[0]);
+    }
+    
+    // Convert a single file
+    if (!util::isDirectory(source) || (format == FILETYPE_DIR && !util::isDirectory(target))) {
+        
+        DiskConverter::convert(source, target, format);
+        return;
+    }
+    
+    // Convert all files in a directory
+    if (!util::isDirectory(target) && !util::createDirectory(target)) {
+        throw VAError(ERROR_FILE_CANT_CREATE, target);
+    }
+    auto jobs = DiskConverter::makeJobs(source, target, format);
+    auto failed = DiskConverter::convert(jobs);
+    
+    for (auto &job : jobs) {
+        if (job.error != ERROR_OK) {
+            retroShell << job.source << ": " << ErrorCodeEnum::key(job.error) << '\n';
+        }
+    }
+    retroShell << (isize)jobs.size() << " files processed, ";
+    retroShell << failed << " failed" << '\n';
+}
+
 
 //
 // Rgression testing
@@ -87,6 +122,24 @@ RetroShell::exec <Token::regression, Token::run> (Arguments &argv, long param)
     amiga.regressionTester.run(argv.front());
 }
 
+template <> void
+RetroShell::exec <Token::regression, Token::benchmark> (Arguments &argv, long param)
+{
+    std::stringstream ss;
+    amiga.regressionTester.benchmarkLineHooks(ss);
+
+    *this << ss;
+}
+
+template <> void
+RetroShell::exec <Token::regression, Token::sse> (Arguments &argv, long param)
+{
+    std::stringstream ss;
+    amiga.regressionTester.checkSSE(ss);
+
+    *this << ss;
+}
+
 template <> void
 RetroShell::exec <Token::screenshot, Token::set, Token::filename> (Arguments &argv, long param)
 {
@@ -312,6 +365,19 @@ RetroShell::exec <Token::cpu, Token::jump> (Arguments &argv, long param)
     amiga.cpu.jump((u32)value);
 }
 
+template <> void
+RetroShell::exec <Token::cpu, Token::trace, Token::start> (Arguments &argv, long param)
+{
+    amiga.cpu.startTracing(argv.front());
+}
+
+template <> void
+RetroShell::exec <Token::cpu, Token::trace, Token::stop> (Arguments &argv, long param)
+{
+    amiga.cpu.stopTracing();
+    *this << (long)amiga.cpu.tracer.recordedInstructions() << " instructions recorded" << '\n';
+}
+
 
 //
 // CIA
@@ -518,6 +584,24 @@ RetroShell::exec <Token::denise, Token::set, Token::clxplfplf> (Arguments &argv,
     amiga.configure(OPT_CLX_PLF_PLF, util::parseBool(argv.front()));
 }
 
+template <> void
+RetroShell::exec <Token::denise, Token::set, Token::frameskip> (Arguments &argv, long param)
+{
+    amiga.configure(OPT_FRAME_SKIP, util::parseNum(argv.front()));
+}
+
+template <> void
+RetroShell::exec <Token::denise, Token::set, Token::skipinterval> (Arguments &argv, long param)
+{
+    amiga.configure(OPT_FRAME_SKIP_INTERVAL, util::parseNum(argv.front()));
+}
+
+template <> void
+RetroShell::exec <Token::denise, Token::set, Token::warpskip> (Arguments &argv, long param)
+{
+    amiga.configure(OPT_WARP_FRAME_SKIP, util::parseBool(argv.front()));
+}
+
 template <> void
 RetroShell::exec <Token::denise, Token::hide, Token::bitplanes> (Arguments &argv, long param)
 {
@@ -661,6 +745,24 @@ RetroShell::exec <Token::dmadebugger, Token::hide, Token::refresh> (Arguments& a
     amiga.configure(OPT_DMA_DEBUG_ENABLE, DMA_CHANNEL_REFRESH, false);
 }
 
+template <> void
+RetroShell::exec <Token::dmadebugger, Token::record, Token::start> (Arguments& argv, long param)
+{
+    amiga.agnus.dmaDebugger.startRecording();
+}
+
+template <> void
+RetroShell::exec <Token::dmadebugger, Token::record, Token::stop> (Arguments& argv, long param)
+{
+    amiga.agnus.dmaDebugger.stopRecording();
+}
+
+template <> void
+RetroShell::exec <Token::dmadebugger, Token::record, Token::save> (Arguments& argv, long param)
+{
+    amiga.agnus.dmaDebugger.saveRecording(argv.front());
+}
+
 
 //
 // Monitor
@@ -690,6 +792,18 @@ RetroShell::exec <Token::monitor, Token::set, Token::saturation> (Arguments& arg
     amiga.configure(OPT_SATURATION, util::parseNum(argv.front()));
 }
 
+template <> void
+RetroShell::exec <Token::monitor, Token::set, Token::format> (Arguments& argv, long param)
+{
+    amiga.configure(OPT_FRAME_FORMAT, util::parseEnum <FrameFormatEnum> (argv.front()));
+}
+
+template <> void
+RetroShell::exec <Token::monitor, Token::set, Token::renderthread> (Arguments& argv, long param)
+{
+    amiga.configure(OPT_RENDER_THREAD, util::parseBool(argv.front()));
+}
+
 
 //
 // Audio
@@ -10,53 +10,127 @@
 #include "config.h"
 #include "TextStorage.h"
 
-string
+const string &
 TextStorage::operator [] (isize i) const
 {
     assert(i >= 0 && i < size());
-    return storage[i];
+    return line(first + i).text;
 }
 
-string&
-TextStorage::operator [] (isize i)
+const TextStorage::Line &
+TextStorage::line(isize nr) const
 {
-    assert(i >= 0 && i < size());
-    return storage[i];
+    assert(nr >= begin() && nr < end());
+
+    // All chunks except the last one are completely filled
+    auto i = nr - first;
+    return chunks[i / chunkSize][i % chunkSize];
 }
 
-void
-TextStorage::text(string &all)
+const string &
+TextStorage::text()
 {
-    auto count = size();
-    
-    all = "";
-    for (isize i = 0; i < count; i++) {
-        
-        all += storage[i];
-        if (i < count - 1) all += '\n';
+    if (cacheVersion == version) return cache;
+
+    isize from;
+
+    if (cacheCleared != cleared || cacheFirst != first || cacheVersion < 0) {
+
+        // Recreate the whole text
+        cache.clear();
+        from = first;
+
+    } else {
+
+        // Only the previously last line and the new lines need an update
+        cache.resize(cacheLastOffset);
+        from = cacheEnd - 1;
+    }
+
+    for (isize i = from; i < end(); i++) {
+
+        if (i != from) cache += '\n';
+        if (i == end() - 1) cacheLastOffset = cache.size();
+        cache += line(i).text;
+    }
+
+    cacheVersion = version;
+    cacheCleared = cleared;
+    cacheFirst = first;
+    cacheEnd = end();
+
+    return cache;
+}
+
+isize
+TextStorage::firstChange(i64 since) const
+{
+    if (since < cleared) return begin();
+
+    // Find the first line with a newer version (the versions are sorted)
+    isize lo = begin(), hi = end();
+    while (lo < hi) {
+
+        auto mid = lo + (hi - lo) / 2;
+        if (line(mid).version > since) hi = mid; else lo = mid + 1;
     }
+    return lo;
+}
+
+TextStorage::Delta
+TextStorage::delta(i64 since) const
+{
+    Delta result;
+
+    result.version = version;
+    result.reset = since < cleared;
+    result.begin = begin();
+    result.first = firstChange(since);
+
+    for (isize i = result.first; i < end(); i++) {
+        result.lines.push_back(line(i).text);
+    }
+
+    return result;
 }
 
 void
 TextStorage::clear()
 {
-    storage.clear();
-    storage.push_back("");
+    // Continue the line numbering
+    first += count;
+    count = 0;
+
+    chunks.clear();
+    cleared = ++version;
+
+    append("");
 }
 
 void
-TextStorage::append(const string &line)
+TextStorage::append(const string &text)
 {
-    storage.push_back(line);
- 
-    // Remove old entries if the storage grows too large
-    while (storage.size() > capacity) storage.erase(storage.begin());
+    if (chunks.empty() || (isize)chunks.back().size() == chunkSize) {
+
+        chunks.emplace_back();
+        chunks.back().reserve(chunkSize);
+    }
+    chunks.back().push_back(Line { text, ++version });
+    count++;
+
+    // Remove the oldest chunk if the storage grows too large
+    while (count - (isize)chunks.front().size() >= capacity) {
+
+        first += (isize)chunks.front().size();
+        count -= (isize)chunks.front().size();
+        chunks.pop_front();
+    }
 }
 
 TextStorage&
 TextStorage::operator<<(char c)
 {
-    assert(!storage.empty());
+    assert(!chunks.empty());
  
     switch (c) {
             
@@ -67,12 +141,16 @@ TextStorage::operator<<(char c)
             
         case '\r':
 
-            storage.back() = "";
+            back() = Line { "", ++version };
             break;
             
         default:
             
-            if (isprint(c)) storage.back() += c;
+            if (isprint(c)) {
+
+                back().text += c;
+                back().version = ++version;
+            }
             break;
     }
     
@@ -82,7 +160,17 @@ TextStorage::operator<<(char c)
 TextStorage&
 TextStorage::operator<<(const string &s)
 {
-    for (auto &c : s) *this << c;
+    for (usize i = 0; i < s.size();) {
+
+        if (s[i] == '\n' || s[i] == '\r') { *this << s[i++]; continue; }
+
+        // Add all characters up to the next line break in one go
+        auto &line = back();
+        for (; i < s.size() && s[i] != '\n' && s[i] != '\r'; i++) {
+            if (isprint(s[i])) line.text += s[i];
+        }
+        line.version = ++version;
+    }
     return *this;
 }
 
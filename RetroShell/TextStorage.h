@@ -10,59 +10,158 @@
 #pragma once
 
 #include "Macros.h"
+#include <deque>
 #include <sstream>
 #include <fstream>
 #include <vector>
 
+/* The text storage keeps the output of RetroShell. Text is only appended,
+ * i.e., the last line is the only line that ever changes. Lines are stored in
+ * chunks. When the storage grows too large, the oldest chunk is dropped as a
+ * whole.
+ *
+ * Each line is tagged with the storage version of its latest modification.
+ * Because only the last line changes, the tags grow monotonically. This
+ * enables a front-end to ask for the lines that have changed since a
+ * certain version without re-reading the whole storage.
+ *
+ * Lines are addressed in two ways. The operator [] takes an index relative
+ * to the oldest stored line. The delta API uses absolute line numbers, which
+ * are not affected by dropping old chunks.
+ */
 class TextStorage {
 
     // Maximum number of stored lines
-    static constexpr usize capacity = 512;
-    
+    static constexpr isize capacity = 512;
+
+    // Number of lines per chunk
+    static constexpr isize chunkSize = 64;
+
+    // A single line together with the version of its latest modification
+    struct Line {
+
+        string text;
+        i64 version;
+    };
+
     // The stored lines
-    std::vector<string> storage;
-        
-    
+    std::deque<std::vector<Line>> chunks;
+
+    // The absolute number of the first stored line
+    isize first = 0;
+
+    // The number of stored lines
+    isize count = 0;
+
+    // Incremented with each modification
+    i64 version = 0;
+
+    // The version of the latest call to clear()
+    i64 cleared = 0;
+
+    // Cached result of text()
+    string cache;
+    i64 cacheVersion = -1;
+    i64 cacheCleared = -1;
+    isize cacheFirst = 0;
+    isize cacheEnd = 0;
+    usize cacheLastOffset = 0;
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    TextStorage() { clear(); }
+
+
     //
     // Reading
     //
-    
+
 public:
-    
+
     // Returns the number of stored lines
-    isize size() const { return (isize)storage.size(); }
+    isize size() const { return count; }
 
     // Returns a single line
-    string operator [] (isize i) const;
-    string& operator [] (isize i);
+    const string &operator [] (isize i) const;
 
     // Returns the whole storage contents
-    void text(string &all);
-            
-    
+    const string &text();
+    void text(string &all) { all = text(); }
+
+
+    //
+    // Reading incrementally
+    //
+
+public:
+
+    // Changes that have occurred since a certain version
+    struct Delta {
+
+        // The storage version the delta refers to
+        i64 version;
+
+        // Indicates if the storage has been cleared
+        bool reset;
+
+        // The absolute number of the oldest stored line
+        isize begin;
+
+        // The absolute number of the first changed line
+        isize first;
+
+        // The new contents of all lines starting at 'first'
+        std::vector<string> lines;
+    };
+
+    // Returns the current version
+    i64 getVersion() const { return version; }
+
+    // Returns the absolute numbers of the oldest line and the line after the last one
+    isize begin() const { return first; }
+    isize end() const { return first + count; }
+
+    // Returns the absolute number of the first line changed after a certain version
+    isize firstChange(i64 since) const;
+
+    // Returns all lines that have been changed after a certain version
+    Delta delta(i64 since) const;
+
+
     //
     // Writing
     //
-    
+
 public:
-    
+
     // Initializes the storage with a single empty line
     void clear();
-    
+
 private:
-    
+
+    // Returns a line by its absolute number
+    const Line &line(isize nr) const;
+
+    // Returns the last line (which is the only one that can be modified)
+    Line &back() { return chunks.back().back(); }
+
     // Appends a new line
     void append(const string &line);
 
 public:
-    
+
     // Appends a single character or a string
     TextStorage &operator<<(char c);
     TextStorage &operator<<(const string &s);
-    
+
     // Prints the welcome message
     void welcome();
-    
+
     // Prints the help line
     void printHelp();
 };
@@ -10,6 +10,8 @@
 #pragma once
 
 #include "Types.h"
+#include <algorithm>
+#include <atomic>
 #include <utility>
 
 namespace util {
@@ -21,6 +23,8 @@ namespace util {
  *          SortedArray : A fixed size array with sorted insert
  *           RingBuffer : A standard ringbuffer
  *     SortedRingBuffer : A standard ringbuffer with sorted insert
+ * ConcurrentRingBuffer : A lock-free ringbuffer for passing data between
+ *                        exactly one producer thread and one consumer thread
  */
 
 //
@@ -285,4 +289,71 @@ struct SortedRingBuffer : public RingBuffer<T, capacity>
     }
 };
 
+//
+// Concurrent ringbuffer
+//
+
+template <class T, isize capacity> struct ConcurrentRingBuffer
+{
+    static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+
+    // Element storage
+    T elements[capacity];
+
+    /* Read and write counters. The counters are never wrapped around. The
+     * write counter is only modified by the producer and the read counter is
+     * only modified by the consumer.
+     */
+    std::atomic<isize> r = 0;
+    std::atomic<isize> w = 0;
+
+
+    //
+    // Querying the fill status
+    //
+
+    isize cap() const { return capacity; }
+    isize count() const { return w.load(std::memory_order_acquire) - r.load(std::memory_order_acquire); }
+    isize free() const { return capacity - count(); }
+    bool isEmpty() const { return count() == 0; }
+    bool isFull() const { return count() == capacity; }
+
+
+    //
+    // Reading and writing elements (consumer side)
+    //
+
+    T read()
+    {
+        assert(!isEmpty());
+
+        auto oldr = r.load(std::memory_order_relaxed);
+        auto result = elements[oldr & (capacity - 1)];
+        r.store(oldr + 1, std::memory_order_release);
+        return result;
+    }
+
+    // Discards all elements
+    void clear() { r.store(w.load(std::memory_order_acquire), std::memory_order_release); }
+
+
+    //
+    // Writing elements (producer side)
+    //
+
+    // Writes as many elements as possible and returns the number of written elements
+    isize write(const T *src, isize n)
+    {
+        auto oldw = w.load(std::memory_order_relaxed);
+        auto count = std::min(n, capacity - (oldw - r.load(std::memory_order_acquire)));
+
+        for (isize i = 0; i < count; i++) {
+            elements[(oldw + i) & (capacity - 1)] = src[i];
+        }
+        w.store(oldw + count, std::memory_order_release);
+        return count;
+    }
+};
+
 }
@@ -10,6 +10,15 @@
 #include "config.h"
 #include "SSEUtils.h"
 #include "Macros.h"
+#include <array>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 namespace util {
 
@@ -56,4 +65,143 @@ void transposeSSE(u16 *source, u8* target)
 
 #endif
 
+
+//
+// Planar to chunky conversion
+//
+
+// Spreads the bits of a byte over eight bytes (MSB first)
+static constexpr auto spread8 = []() {
+
+    std::array<u64, 256> table { };
+    for (isize i = 0; i < 256; i++) {
+        for (isize j = 0; j < 8; j++) {
+            if (i & (0x80 >> j)) table[i] |= u64(1) << (8 * j);
+        }
+    }
+    return table;
+}();
+
+// Spreads the bits of a nibble over eight bytes (MSB first, each bit twice)
+static constexpr auto spread4 = []() {
+
+    std::array<u64, 16> table { };
+    for (isize i = 0; i < 16; i++) {
+        for (isize j = 0; j < 4; j++) {
+            if (i & (0x8 >> j)) table[i] |= u64(0x0101) << (16 * j);
+        }
+    }
+    return table;
+}();
+
+template <bool hires> static void
+planarToChunkyScalar(u16 p0, u16 p1, u16 p2, isize shift, u8 mask, u8 keep, u8 *target)
+{
+    // The tables assume a little endian byte order
+    const u64 mask64 = mask * 0x0101010101010101;
+    const u64 keep64 = keep * 0x0101010101010101;
+
+    // Number of source bits processed per 64-bit chunk
+    constexpr isize bits = hires ? 8 : 4;
+    constexpr u16 sel = (1 << bits) - 1;
+
+    const u64 *spread = hires ? spread8.data() : spread4.data();
+
+    for (isize i = 0, s = 16 - bits; s >= 0; i += 8, s -= bits) {
+
+        u64 chunky =
+        spread[(p0 >> s) & sel] << shift |
+        spread[(p1 >> s) & sel] << (shift + 2) |
+        spread[(p2 >> s) & sel] << (shift + 4);
+
+        u64 pixels;
+        std::memcpy(&pixels, target + i, 8);
+        pixels = (pixels & keep64) | (chunky & mask64);
+        std::memcpy(target + i, &pixels, 8);
+    }
+}
+
+#if defined(__SSE2__)
+
+template <bool hires> static void
+planarToChunkySSE(u16 p0, u16 p1, u16 p2, isize shift, u8 mask, u8 keep, u8 *target)
+{
+    // Bit to test in each byte lane
+    const __m128i bits = hires ?
+    _mm_setr_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1) :
+    _mm_setr_epi8(-128, -128, 64, 64, 32, 32, 16, 16, 8, 8, 4, 4, 2, 2, 1, 1);
+
+    // Converts one source byte per lane into a chunky pixel plane
+    auto convert = [&](__m128i p, isize bit) {
+
+        __m128i set = _mm_cmpeq_epi8(_mm_and_si128(p, bits), bits);
+        return _mm_and_si128(set, _mm_set1_epi8(char((1 << bit) & mask)));
+    };
+
+    // Merges the chunky pixels into the target buffer
+    auto merge = [&](__m128i chunky, u8 *dst) {
+
+        __m128i pixels = _mm_loadu_si128((__m128i *)dst);
+        pixels = _mm_and_si128(pixels, _mm_set1_epi8(char(keep)));
+        _mm_storeu_si128((__m128i *)dst, _mm_or_si128(pixels, chunky));
+    };
+
+    if constexpr (hires) {
+
+        // Lanes 0 - 7 are fed by the upper byte, lanes 8 - 15 by the lower byte
+        auto spread = [](u16 p) {
+            return _mm_unpacklo_epi64(_mm_set1_epi8(char(p >> 8)), _mm_set1_epi8(char(p)));
+        };
+
+        merge(_mm_or_si128(_mm_or_si128(convert(spread(p0), shift),
+                                        convert(spread(p1), shift + 2)),
+                           convert(spread(p2), shift + 4)), target);
+
+    } else {
+
+        // Each lane is fed by the same source byte
+        auto chunky = [&](isize s) {
+
+            return _mm_or_si128(_mm_or_si128(convert(_mm_set1_epi8(char(p0 >> s)), shift),
+                                             convert(_mm_set1_epi8(char(p1 >> s)), shift + 2)),
+                                convert(_mm_set1_epi8(char(p2 >> s)), shift + 4));
+        };
+
+#if defined(__AVX2__)
+
+        __m256i c = _mm256_inserti128_si256(_mm256_castsi128_si256(chunky(8)), chunky(0), 1);
+        __m256i pixels = _mm256_loadu_si256((__m256i *)target);
+        pixels = _mm256_and_si256(pixels, _mm256_set1_epi8(char(keep)));
+        _mm256_storeu_si256((__m256i *)target, _mm256_or_si256(pixels, c));
+
+#else
+
+        merge(chunky(8), target);
+        merge(chunky(0), target + 16);
+
+#endif
+    }
+}
+
+#endif
+
+template <bool hires> void
+planarToChunky(u16 p0, u16 p1, u16 p2, isize shift, u8 mask, u8 keep, u8 *target)
+{
+#if defined(__SSE2__)
+
+    if constexpr (!NO_SSE) {
+
+        planarToChunkySSE<hires>(p0, p1, p2, shift, mask, keep, target);
+        return;
+    }
+
+#endif
+
+    planarToChunkyScalar<hires>(p0, p1, p2, shift, mask, keep, target);
+}
+
+template void planarToChunky<false>(u16, u16, u16, isize, u8, u8, u8 *);
+template void planarToChunky<true>(u16, u16, u16, isize, u8, u8, u8 *);
+
 }
@@ -35,4 +35,18 @@ namespace util {
  */
 void transposeSSE(u16 *source, u8* target);
 
+/* Converts three bitplanes into chunky pixels and merges them into a pixel
+ * buffer. The bits of the three planes are stored at bit positions shift,
+ * shift + 2, and shift + 4. The most significant bit belongs to the leftmost
+ * pixel. In hires mode, 16 pixels are written. In lores mode, each pixel is
+ * doubled and 32 pixels are written. Each pixel is merged according to
+ *
+ *     target[i] = (target[i] & keep) | (chunky[i] & mask)
+ *
+ * The function utilizes SSE2 or AVX2 instructions if the compiler provides
+ * them and falls back to a table-based implementation otherwise.
+ */
+template <bool hires>
+void planarToChunky(u16 p0, u16 p1, u16 p2, isize shift, u8 mask, u8 keep, u8 *target);
+
 }
@@ -8,6 +8,7 @@
 // -----------------------------------------------------------------------------
 
 #include "StringUtils.h"
+#include <cstring>
 #include <sstream>
 
 namespace util {
@@ -30,6 +31,59 @@ parseHex(const string &s, isize *result)
     }
 }
 
+string
+hexEncode(const u8 *data, isize count)
+{
+    // Lookup table with the two hex digits of each byte
+    static const struct Table {
+
+        char digits[256][2];
+
+        Table() {
+            for (isize i = 0; i < 256; i++) {
+                digits[i][0] = "0123456789abcdef"[i >> 4];
+                digits[i][1] = "0123456789abcdef"[i & 0xF];
+            }
+        }
+    } table;
+
+    string result(2 * count, '0');
+    auto dst = result.data();
+
+    for (isize i = 0; i < count; i++, dst += 2) {
+        std::memcpy(dst, table.digits[data[i]], 2);
+    }
+    return result;
+}
+
+bool
+hexDecode(const string &s, u8 *data, isize count)
+{
+    // Lookup table with the value of each hex digit (0xFF = invalid)
+    static const struct Table {
+
+        u8 values[256];
+
+        Table() {
+            std::memset(values, 0xFF, sizeof(values));
+            for (isize i = 0; i < 10; i++) values['0' + i] = (u8)i;
+            for (isize i = 0; i < 6; i++) values['a' + i] = values['A' + i] = (u8)(10 + i);
+        }
+    } table;
+
+    if ((isize)s.size() != 2 * count) return false;
+
+    u8 invalid = 0;
+    for (isize i = 0; i < count; i++) {
+
+        auto hi = table.values[(u8)s[2 * i]];
+        auto lo = table.values[(u8)s[2 * i + 1]];
+        invalid |= (hi | lo) & 0xF0;
+        data[i] = (u8)(hi << 4 | lo);
+    }
+    return invalid == 0;
+}
+
 string
 lowercased(const string& s)
 {
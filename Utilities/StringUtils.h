@@ -24,6 +24,12 @@ bool parseHex(const string &s, isize *result);
 // Converts an integer value to a hexadecimal string representation
 template <isize digits> string hexstr(isize number);
 
+// Converts a byte stream to a hexadecimal string (two digits per byte)
+string hexEncode(const u8 *data, isize count);
+
+// Converts a hexadecimal string back to a byte stream
+bool hexDecode(const string &s, u8 *data, isize count);
+
 
 //
 // Transforming
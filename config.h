@@ -77,6 +77,11 @@ struct FloatStereo; typedef FloatStereo SampleType;
 //
 
 static const int NO_SSE          = 0; // Don't use SSE extensions
+static const int NO_IMAGE_CACHE  = 0; // Don't share Roms and disks among instances
+static const int NO_COP_CACHE    = 0; // Don't cache Copper wakeup positions
+static const int NO_BUS_SKIP     = 0; // Retry blocked DMA cycles one by one
+static const int NO_BPL_CACHE    = 0; // Don't cache bitplane event tables
+static const int NO_DMA_DEBUGGER = 0; // Compile without the DMA debugger
 
 
 //
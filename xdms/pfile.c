@@ -35,7 +35,13 @@ static USHORT Process_Track(UCHAR *, UCHAR *, USHORT, USHORT, USHORT);
 static USHORT Unpack_Track(UCHAR *, UCHAR *, USHORT, USHORT, UCHAR, UCHAR);
 static void printbandiz(UCHAR *, USHORT);
 static void dms_decrypt(UCHAR *, USHORT);
+
+/* Callback receiving the unpacked tracks. A nonzero return value aborts
+ * unpacking with ERR_CANTWRITE. */
+typedef int (*DMSTrackHandler)(void *context, USHORT number, const UCHAR *data, size_t size);
+
 USHORT extractDMS(const UCHAR *in, size_t inSize, UCHAR **out, size_t *outSize, int verbose);
+USHORT streamDMS(const UCHAR *in, size_t inSize, DMSTrackHandler handler, void *context, int verbose);
 
 static char modes[7][7]={"NOCOMP","SIMPLE","QUICK ","MEDIUM","DEEP  ","HEAVY1","HEAVY2"};
 static USHORT PWDCRC;
@@ -43,8 +49,12 @@ static USHORT PWDCRC;
 static const UCHAR* inbuf;
 static size_t insize;
 static size_t inpos;
-static UCHAR* outbuf;
-static size_t outpos;
+static DMSTrackHandler trackHandler;
+static void* trackContext;
+
+/* Work buffers (allocated once and reused for all archives) */
+static UCHAR* b1;
+static UCHAR* b2;
 
 static size_t In_Read(void* buf, size_t elem_size, size_t elem_count)
 {
@@ -56,19 +66,11 @@ static size_t In_Read(void* buf, size_t elem_size, size_t elem_count)
     return num_bytes;
 }
 
-static size_t Out_Write(void* buf, size_t elem_size, size_t elem_count)
+static size_t Out_Write(USHORT number, void* buf, size_t elem_size, size_t elem_count)
 {
     const size_t num_bytes = elem_size * elem_count;
-    UCHAR* new_buf = realloc(outbuf, outpos + num_bytes);
-    if (!new_buf) {
-        free(outbuf);
-        outbuf = NULL;
+    if (trackHandler(trackContext, number, (const UCHAR *)buf, num_bytes))
         return 0;
-    }
-    outbuf = new_buf;
-
-    memcpy(outbuf + outpos, buf, num_bytes);
-    outpos += num_bytes;
 
     return num_bytes;
 }
@@ -77,8 +79,17 @@ UCHAR* text;
 
 int OverrideErrors;
 
-// New entry point for vAmiga (Dirk Hoffmann)
-USHORT extractDMS(const UCHAR *in, size_t inSize, UCHAR **out, size_t *outSize, int verbose) {
+static int Alloc_Buffers(void)
+{
+    if (!b1) b1 = (UCHAR *)calloc((size_t)TRACK_BUFFER_LEN,1);
+    if (!b2) b2 = (UCHAR *)calloc((size_t)TRACK_BUFFER_LEN,1);
+    if (!text) text = (UCHAR *)calloc((size_t)TEMP_BUFFER_LEN,1);
+
+    return b1 && b2 && text;
+}
+
+// Streaming entry point for vAmiga. Passes each unpacked track to a handler.
+USHORT streamDMS(const UCHAR *in, size_t inSize, DMSTrackHandler handler, void *context, int verbose) {
     
     USHORT cmd = CMD_UNPACK;
     USHORT opt = verbose ? OPT_VERBOSE : 0;
@@ -87,46 +98,22 @@ USHORT extractDMS(const UCHAR *in, size_t inSize, UCHAR **out, size_t *outSize,
     
     USHORT from, to, geninfo, c_version, cmode, hcrc, disktype, ret;
     ULONG pkfsize, unpkfsize;
-    UCHAR *b1, *b2;
     time_t date;
 
-    *out = NULL;
-    *outSize = 0;
-
-    assert(!outbuf);
-    
     inbuf = in;
     insize = inSize;
     inpos = 0;
-    outbuf = NULL;
-    outpos = 0;
+    trackHandler = handler;
+    trackContext = context;
     
-    b1 = (UCHAR *)calloc((size_t)TRACK_BUFFER_LEN,1);
-    if (!b1) return ERR_NOMEMORY;
-    b2 = (UCHAR *)calloc((size_t)TRACK_BUFFER_LEN,1);
-    if (!b2) {
-        free(b1);
-        return ERR_NOMEMORY;
-    }
-    text = (UCHAR *)calloc((size_t)TEMP_BUFFER_LEN,1);
-    if (!text) {
-        free(b1);
-        free(b2);
-        return ERR_NOMEMORY;
-    }
+    if (!Alloc_Buffers()) return ERR_NOMEMORY;
         
     if (In_Read(b1, 1, HEADLEN) != HEADLEN) {
-        free(b1);
-        free(b2);
-        free(text);
         return ERR_SREAD;
     }
     
     if ( (b1[0] != 'D') || (b1[1] != 'M') || (b1[2] != 'S') || (b1[3] != '!') ) {
         /*  Check the first 4 bytes of file to see if it is "DMS!"  */
-        free(b1);
-        free(b2);
-        free(text);
         return ERR_NOTDMS;
     }
     
@@ -134,9 +121,6 @@ USHORT extractDMS(const UCHAR *in, size_t inSize, UCHAR **out, size_t *outSize,
     /* Header CRC */
     
     if (hcrc != CreateCRC(b1+4,(ULONG)(HEADLEN-6))) {
-        free(b1);
-        free(b2);
-        free(text);
         return ERR_HCRC;
     }
     
@@ -152,13 +136,12 @@ USHORT extractDMS(const UCHAR *in, size_t inSize, UCHAR **out, size_t *outSize,
     disktype = (USHORT) ((b1[50]<<8) | b1[51]);        /*  Type of compressed disk  */
     cmode = (USHORT) ((b1[52]<<8) | b1[53]);        /*  Compression mode mostly used in this archive  */
     
+    (void)date; (void)from; (void)to; (void)pkfsize; (void)unpkfsize; (void)c_version; (void)cmode;
+
     PWDCRC = PCRC;
     
     if (disktype == 7) {
         /*  It's not a DMS compressed disk image, but a FMS archive  */
-        free(b1);
-        free(b2);
-        free(text);
         return ERR_FMS;
     }
     
@@ -188,15 +171,59 @@ USHORT extractDMS(const UCHAR *in, size_t inSize, UCHAR **out, size_t *outSize,
     /*  So, when we find something that is not a track header,   */
     /*  we suppose that the valid data is over. And say it's ok. */
     if (ret == ERR_NOTTRACK) ret = NO_PROBLEM;
-        
-    free(b1);
-    free(b2);
-    free(text);
-
-    *out = outbuf;
-    *outSize = outpos;
-    outbuf = NULL;
     
+    trackHandler = NULL;
+    trackContext = NULL;
+
+    return ret;
+}
+
+/* Output buffer of extractDMS */
+struct OutBuffer {
+    UCHAR* data;
+    size_t size;
+    size_t capacity;
+};
+
+static int Append_Track(void *context, USHORT number, const UCHAR *data, size_t size)
+{
+    struct OutBuffer *out = (struct OutBuffer *)context;
+    (void)number;
+
+    if (out->size + size > out->capacity) {
+
+        /* Grow geometrically to avoid reallocating on each track */
+        size_t capacity = out->capacity ? 2 * out->capacity : 1024 * 1024;
+        while (capacity < out->size + size) capacity *= 2;
+
+        UCHAR* new_buf = realloc(out->data, capacity);
+        if (!new_buf) return 1;
+
+        out->data = new_buf;
+        out->capacity = capacity;
+    }
+
+    memcpy(out->data + out->size, data, size);
+    out->size += size;
+
+    return 0;
+}
+
+// New entry point for vAmiga (Dirk Hoffmann)
+USHORT extractDMS(const UCHAR *in, size_t inSize, UCHAR **out, size_t *outSize, int verbose) {
+
+    struct OutBuffer buffer = { NULL, 0, 0 };
+    USHORT ret = streamDMS(in, inSize, Append_Track, &buffer, verbose);
+
+    if (ret != NO_PROBLEM) {
+        free(buffer.data);
+        buffer.data = NULL;
+        buffer.size = 0;
+    }
+
+    *out = buffer.data;
+    *outSize = buffer.size;
+
     return ret;
 }
 
@@ -523,7 +550,7 @@ static USHORT Process_Track(UCHAR *b1, UCHAR *b2,
             }
         }
 
-        if (Out_Write(b2, 1, (size_t) unpklen) != unpklen)
+        if (Out_Write(number, b2, 1, (size_t) unpklen) != unpklen)
             return ERR_CANTWRITE;
 
         if (opt == OPT_VERBOSE) {